@@ -1004,6 +1004,8 @@
   #define JUNCTION_DEVIATION_MM 0.01 // (mm) Distance from real junction edge
   #define JD_HANDLE_SMALL_SEGMENTS    // Use curvature estimation instead of just the junction angle
                                       // for small segments (< 1mm) with large junction angles (> 135°).
+  //#define JD_FAST_MATH              // Get the junction speed from the junction vector length and a fast 1/sqrt,
+                                      // without SQRT or division. Also a more exact angle for small segments.
 #endif
 
 /**
@@ -1593,6 +1595,10 @@
   #define SEGMENT_LEVELED_MOVES
   #define LEVELED_SEGMENT_LENGTH 5.0 // (mm) Length of all segments (except the last one)
 
+  // Merge leveled segments (or UBL's splits at mesh lines) where the Z correction
+  // along them stays this close to a straight line. Fewer planner blocks on a flat bed.
+  //#define LEVELED_MERGE_TOLERANCE 5 // (µm)
+
   /**
    * Enable the G26 Mesh Validation Pattern tool.
    */
@@ -1634,6 +1640,15 @@
       #define BILINEAR_SUBDIVISIONS 3
     #endif
 
+    // Keep a table of interpolation terms for each grid cell, updated with
+    // the mesh, so each Z lookup is a few multiply-adds. Costs 16 bytes per cell.
+    //#define ABL_BILINEAR_PATCHES
+    #if ENABLED(ABL_BILINEAR_PATCHES)
+      // Use integer math for the table and lookups. Faster on 8-bit boards and
+      // half the size. Heights are rounded to 1µm and must stay within ±16mm.
+      //#define ABL_BILINEAR_FIXED_POINT
+    #endif
+
   #endif
 
 #elif ENABLED(AUTO_BED_LEVELING_UBL)
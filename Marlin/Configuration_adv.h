@@ -1056,6 +1056,24 @@
 #define SLOWDOWN
 #if ENABLED(SLOWDOWN)
   #define SLOWDOWN_DIVISOR 2
+  //#define SLOWDOWN_BY_TIME    // Slow down by the time left in the buffer instead of the number of blocks,
+                                // so tiny segments keep (BLOCK_BUFFER_SIZE / SLOWDOWN_DIVISOR) * MINSEGMENTTIME queued.
+#endif
+
+/**
+ * Merge Collinear Moves
+ * Extend the last queued block when the next move continues it in a straight line,
+ * so the micro-segments slicers emit on walls and gentle curves take fewer blocks.
+ * The moves must have the same feedrate and extruder, and the same extrusion per mm.
+ * A block is only merged into with enough queued ahead of it that the steppers can't
+ * reach it while it's planned again. Not for kinematic machines.
+ */
+//#define MERGE_COLLINEAR_MOVES
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  #define MERGE_COLLINEAR_TOLERANCE 0.005 // (mm) Max. distance of the merged points from the block
+  #define MERGE_COLLINEAR_E_RATIO    0.02 // Max. relative difference in extrusion per mm
+  #define MERGE_COLLINEAR_AHEAD         4 // Min. blocks queued ahead of the block to merge into
+  #define MERGE_COLLINEAR_MIN_TIME  20000 // (µs) Min. move time queued ahead of it, where the planner tracks it
 #endif
 
 /**
@@ -1177,10 +1195,79 @@
  * Adaptive Step Smoothing increases the resolution of multi-axis moves, particularly at step frequencies
  * below 1kHz (for AVR) or 10kHz (for ARM), where aliasing between axes in multi-axis moves causes audible
  * vibration and surface artifacts. The algorithm adapts to provide the best possible step smoothing at the
- * lowest stepping frequencies.
+ * lowest stepping frequencies. Moves where every motor steps together, such as a single-axis move, are
+ * left alone. The others are oversampled as far as the estimated ISR time for their motors allows.
  */
 //#define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Fixed-point trapezoids. Calculate the acceleration and deceleration step counts of each
+ * block with integer math, using a reciprocal of the acceleration cached when the block is
+ * planned. Avoids the float divisions in the planner recalculation, which are slow on MCUs
+ * without an FPU (e.g., AVR). S_CURVE_ACCELERATION timing still uses float math.
+ * The step counts are exactly rounded for blocks under 2^24 steps, where the float math
+ * can be a few steps off. The LINUX 'program --self-test' checks this.
+ */
+//#define FIXED_POINT_TRAPEZOIDS
+
+/**
+ * AVR only. Build the step timer lookup tables with twice as many entries above 2048 steps/s
+ * and with rounded intervals. Halves the worst timing error at high step rates and removes
+ * its bias toward shorter intervals, at the cost of 1K more flash.
+ */
+//#define HIRES_SPEED_LOOKUPTABLE
+
+/**
+ * Evaluate the S_CURVE_ACCELERATION speed curve from a 65-point table of its shape,
+ * instead of the full polynomial. Much cheaper to set up at the start of each acceleration
+ * and deceleration, and cheaper per step. The speed stays within 0.025% of the curve.
+ */
+//#define S_CURVE_TABLE
+
+/**
+ * Step Compiler
+ *
+ * Trace the lines and accelerations of upcoming blocks ahead of the Stepper ISR, storing a step
+ * event (motors to step) for each step and the timing of each Stepper ISR. The Stepper ISR only
+ * replays the events, so it's shorter and can reach higher step rates. The Temperature ISR keeps
+ * a few milliseconds of steps in the buffer, so the planner can still speed up the blocks after
+ * them. If it runs out anyway, the Stepper ISR compiles its own steps as it goes.
+ */
+//#define STEP_COMPILER
+#if ENABLED(STEP_COMPILER)
+  #define STEP_EVENT_BUFFER_SIZE 128  // Power of 2 from 16 to 256. Uses 4 bytes (AVR) or 8 bytes (32-bit) per event.
+#endif
+
+/**
+ * Input Shaping
+ *
+ * Reduce ringing after sharp corners by splitting every X/Y step into scaled, delayed
+ * copies that cancel out the vibration of the frame at its resonant frequency.
+ *   ZV  - Two impulses over 1/2 period. Shortest delay, so the least smoothing.
+ *   ZVD - Three impulses over a full period. Most tolerant of frequency error.
+ *   MZV - Three impulses over 3/4 period. Between ZV and ZVD.
+ *
+ * Print a ringing test, measure the frequency of the ripples and set it with M593.
+ * Shaping is turned off while homing so the endstops trigger on time.
+ */
+//#define INPUT_SHAPING_X
+//#define INPUT_SHAPING_Y
+#if EITHER(INPUT_SHAPING_X, INPUT_SHAPING_Y)
+  #if ENABLED(INPUT_SHAPING_X)
+    #define SHAPING_TYPE_X      ZV    // ZV, ZVD or MZV
+    #define SHAPING_FREQ_X   40.0f    // (Hz) Resonant frequency of the X axis. 0 to disable.
+    #define SHAPING_ZETA_X   0.15f    // Damping ratio of the X axis (range: 0.0 = no damping to 1.0 = critical damping).
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    #define SHAPING_TYPE_Y      ZV    // ZV, ZVD or MZV
+    #define SHAPING_FREQ_Y   40.0f    // (Hz) Resonant frequency of the Y axis. 0 to disable.
+    #define SHAPING_ZETA_Y   0.15f    // Damping ratio of the Y axis (range: 0.0 = no damping to 1.0 = critical damping).
+  #endif
+  #define SHAPING_MIN_FREQ      20    // (Hz) Lowest frequency accepted by M593
+  #define SHAPING_MAX_STEPRATE 5000   // (steps/s) Highest X/Y step rate that is shaped. Uses 4 bytes of RAM per axis for each
+                                      // step in SHAPING_MAX_STEPRATE / SHAPING_MIN_FREQ. Faster steps are taken unshaped.
+#endif
+
 /**
  * Custom Microstepping
  * Override as-needed for your setup. Up to 3 MS pins are supported.
@@ -2151,13 +2238,25 @@
   #define MAX_ARC_SEGMENT_MM      1.0 // (mm) Maximum length of each arc segment
   #define MIN_CIRCLE_SEGMENTS    72   // Minimum number of segments in a complete circle
   //#define ARC_SEGMENTS_PER_SEC 50   // Use the feedrate to choose the segment length
+  //#define ARC_CHORD_TOLERANCE   5   // (µm) Use the radius to choose the segment length, keeping each chord
+                                      // this close to the arc. Raise MAX_ARC_SEGMENT_MM to let big arcs use fewer.
   #define N_ARC_CORRECTION       25   // Number of interpolated segments between corrections
+  //#define ARC_BLOCKS                // Queue the segments of XY arcs in groups, each as a single block stepped by the Stepper ISR.
+                                      // Frees the planner buffer for arc-heavy G-code. Arcs fall back to linear segments
+                                      // in other planes, with leveling or skew, or near the soft endstops.
+  #if ENABLED(ARC_BLOCKS)
+    #define ARC_BLOCK_CHORDS      8   // Segments in each arc block. Every planner block uses 4 bytes of SRAM per segment, plus 5.
+  #endif
   //#define ARC_P_CIRCLES             // Enable the 'P' parameter to specify complete circles
   //#define SF_ARC_FIX                // Enable only if using SkeinForge with "Arc Point" fillet procedure
 #endif
 
 // G5 Bézier Curve Support with XYZE destination and IJPQ offsets
 //#define BEZIER_CURVE_SUPPORT        // Requires ~2666 bytes
+#if ENABLED(BEZIER_CURVE_SUPPORT)
+  //#define BEZIER_FLATNESS      50   // (µm) Size each segment to keep its chord this close to the curve.
+                                      // Short or gentle curves take fewer segments. See bezierSegments.py.
+#endif
 
 #if EITHER(ARC_SUPPORT, BEZIER_CURVE_SUPPORT)
   //#define CNC_WORKSPACE_PLANES      // Allow G2/G3/G5 to operate in XY, ZX, or YZ planes
@@ -2172,6 +2271,21 @@
  * Preparing your G-code: https://github.com/colinrgodsey/step-daemon
  */
 //#define DIRECT_STEPPING
+#if ENABLED(DIRECT_STEPPING)
+  //#define STEPPER_PAGES 16                // Page pool size, a multiple of 4 up to 252. (256 bytes each)
+  //#define STEPPER_PAGE_FORMAT SP_4x2_256  // SP_4x4D_128, SP_4x2_256, or SP_4x1_512
+  //#define STEPPER_PAGE_TIMEOUT 2000       // (ms) G6 fails a page that is still arriving after this time
+
+  /**
+   * Accept pages compressed with heatshrink (window 8, lookahead 4), sent with '#' in place of '!'
+   * and always with a size byte. The serial ISR collects them and the main loop decodes them, so
+   * the page reads WRITING until it's decoded. G6 waits for that. Adds ~850 bytes of RAM.
+   */
+  //#define DIRECT_STEPPING_COMPRESSION
+  #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+    #define DIRECT_STEPPING_DECODE_BUFFERS 2 // Compressed pages waiting to be decoded: 1, 2, 4 or 8. (256 bytes each)
+  #endif
+#endif
 
 /**
  * G38 Probe Target
@@ -2189,6 +2303,15 @@
 // Moves (or segments) with fewer steps than this will be joined with the next move
 #define MIN_STEPS_PER_SEGMENT 6
 
+/**
+ * Work out the inverse kinematics of DELTA, SCARA, and POLARGRAPH segments
+ * this many at a time. The machine constants are loaded once per batch and
+ * the DELTA math runs as a tight loop the compiler can unroll or vectorize,
+ * raising the number of segments per second the planner can keep up with.
+ * Each segment in a batch takes about 36 bytes of stack. (32-bit only)
+ */
+//#define KINEMATIC_SEGMENT_BATCH 8
+
 /**
  * Minimum delay before and after setting the stepper DIR (in ns)
  *     0 : No delay (Expect at least 10µS since one Stepper ISR must transpire)
@@ -2259,6 +2382,16 @@
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
+/**
+ * Buffer Arena
+ * Keep the BLOCK_BUFFER_SIZE planner blocks and the BUFSIZE command slots in a single
+ * static arena and use 'M577 B<blocks>' to move the split at runtime. Use more planner
+ * blocks for look-ahead with short segments from SD, or more command slots when streaming
+ * over USB, without rebuilding. The arena has room for both sizes above, which are also
+ * the split at startup.
+ */
+//#define BUFFER_ARENA
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -4331,6 +4464,16 @@
   //#define BUFFER_MONITORING
 #endif
 
+/**
+ * ISR Profiler
+ * Time every call of the Stepper ISR, its phases and the Temperature ISR,
+ * and the S-curve speed evaluation.
+ * M578 reports calls, min/avg/max cycles, CPU load and a histogram of
+ * durations for each one. 'M578 R' starts a new measurement window.
+ * Adds some cycles to each profiled call. Uses ~700 bytes of SRAM.
+ */
+//#define ISR_PROFILER
+
 /**
  * Postmortem Debugging captures misbehavior and outputs the CPU status and backtrace to serial.
  * When running in the debugger it will break for debugging. This is useful to help understand
@@ -74,8 +74,8 @@ FORCE_INLINE void HAL_timer_start(const uint8_t timer_num, const uint32_t) {
       // Set the timer pre-scaler
       // Generally we use a divider of 8, resulting in a 2MHz timer
       // frequency on a 16MHz MCU. If you are going to change this, be
-      // sure to regenerate speed_lookuptable.h with
-      // create_speed_lookuptable.py
+      // sure to update HAL_TIMER_RATE, which speed_lookuptable.h uses
+      // to generate its tables.
       SET_CS(1, PRESCALER_8);  //  CS 2 = 1/8 prescaler
 
       // Init Stepper ISR to 122 Hz for quick starting
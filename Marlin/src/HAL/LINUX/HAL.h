@@ -78,6 +78,12 @@ extern MSerialT usb_serial;
 
 inline void HAL_init() {}
 
+#if ENABLED(PLANNER_BENCHMARK)
+  #include "benchmark.h"
+  #define HAL_IDLETASK 1
+  inline void HAL_idletask() { PlannerBenchmark::idle(); }
+#endif
+
 // Utility functions
 #pragma GCC diagnostic push
 #if GCC_VERSION <= 50000
@@ -0,0 +1,289 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+#include "benchmark.h"
+#include "hardware/Timer.h"
+#include "hardware/LinearAxis.h"
+#include "../../gcode/queue.h"
+#include "../../module/motion.h"
+#include "../../module/planner.h"
+#include "../../module/stepper.h"
+
+#if ENABLED(DIRECT_STEPPING)
+  #include "../../feature/direct_stepping.h"
+#endif
+
+#include <fstream>
+#include <string>
+
+extern Timer timers[2];
+
+PlannerBenchmark::Stat PlannerBenchmark::plan,
+                       PlannerBenchmark::recalculate,
+                       PlannerBenchmark::stepper_isr;
+
+static std::ifstream gcode_file;
+static const char *gcode_name;
+static bool end_of_file;
+static uint32_t commands, pages, deadline_misses;
+static uint64_t max_late_ns;
+static std::chrono::steady_clock::time_point host_start;
+
+bool PlannerBenchmark::open(const char * const filename) {
+  gcode_file.open(filename);
+  if (!gcode_file) return false;
+  gcode_name = filename;
+  host_start = std::chrono::steady_clock::now();
+  return true;
+}
+
+// The simulated heaters aren't part of the benchmark, so drop commands that would wait on them
+static bool is_heater_command(const char *cmd) {
+  while (*cmd == ' ') cmd++;
+  if (*cmd != 'M') return false;
+  const int code = atoi(cmd + 1);
+  return code == 104 || code == 109 || code == 140 || code == 190 || code == 141 || code == 191;
+}
+
+#if ENABLED(DIRECT_STEPPING)
+
+  static bool is_page_frame(const std::string &line) {
+    return !line.empty() && (line[0] == DirectStepping::Config::CONTROL_CHAR || TERN0(DIRECT_STEPPING_COMPRESSION, line[0] == DirectStepping::Config::PACKED_CHAR));
+  }
+
+  // A host only sends a page into a FREE page, and a compressed page only when a decode buffer is free
+  static bool page_frame_ready(const std::string &frame) {
+    const page_idx_t page_idx = uint8_t(frame[1]);
+    const DirectStepping::PageState state = page_manager.page_state(page_idx);
+    if (state == DirectStepping::PageState::FAIL) {
+      // The file can't resend it
+      fprintf(stderr, "Page %d failed\n", int(page_idx));
+      exit(1);
+    }
+    if (state != DirectStepping::PageState::FREE) return false;
+    #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+      if (frame[0] == DirectStepping::Config::PACKED_CHAR) {
+        uint8_t decoding = 0;
+        for (int i = 0; i < DirectStepping::Config::NUM_PAGES; i++)
+          if (page_manager.page_state(i) == DirectStepping::PageState::WRITING) decoding++;
+        return decoding < DIRECT_STEPPING_DECODE_BUFFERS;
+      }
+    #endif
+    return true;
+  }
+
+#endif
+
+// Read a line, or a whole page frame if the line starts with one
+static bool read_line(std::string &line) {
+  line.clear();
+  int c = gcode_file.get();
+  if (c == EOF) return false;
+  line += char(c);
+  #if ENABLED(DIRECT_STEPPING)
+    if (is_page_frame(line)) {
+      // Page index, size byte (unless raw and directional), data, checksum
+      const bool sized = !DirectStepping::Config::DIRECTIONAL || line[0] != DirectStepping::Config::CONTROL_CHAR;
+      line += char(gcode_file.get());
+      int size = DirectStepping::Config::PAGE_SIZE;
+      if (sized) {
+        line += char(gcode_file.get());
+        size = uint8_t(line[2]);
+        if (!size) size = 256;
+      }
+      for (int i = 0; i <= size && (c = gcode_file.get()) != EOF; i++) line += char(c);
+      return true;
+    }
+  #endif
+  while (c != '\n' && (c = gcode_file.get()) != EOF) line += char(c);
+  if (line.back() != '\n') line += '\n';
+  return true;
+}
+
+// Fill the serial receive buffer from the file, as a host would
+void PlannerBenchmark::feed() {
+  // With the heaters left out, extrusion has to be allowed cold
+  static std::string line = TERN(PREVENT_COLD_EXTRUSION, "M302 P1\n", "");
+  static size_t pos = 0;
+  while (!end_of_file) {
+    if (pos == line.length()) {
+      pos = 0;
+      if (!read_line(line)) { end_of_file = true; line.clear(); break; }
+      if (is_heater_command(line.c_str())) { line.clear(); continue; }
+      if (TERN0(DIRECT_STEPPING, is_page_frame(line))) pages++; else commands++;
+    }
+    #if ENABLED(DIRECT_STEPPING)
+      // Pages go to the page manager, like the serial RX ISR
+      if (is_page_frame(line)) {
+        if (pos == 0 && !page_frame_ready(line)) break;
+        while (pos < line.length()) page_manager.maybe_store_rxd_char(line[pos++]);
+        continue;
+      }
+      if (!usb_serial.receive_buffer.free()) break;
+      if (page_manager.maybe_store_rxd_char(line[pos])) { pos++; continue; }
+    #else
+      if (!usb_serial.receive_buffer.free()) break;
+    #endif
+    usb_serial.receive_buffer.write(line[pos++]);
+  }
+}
+
+// Jump ahead to the next timer event and run its ISR with the clock running
+void PlannerBenchmark::service_timers() {
+  Timer *next = nullptr;
+  for (Timer &t : timers)
+    if (t.enabled() && (!next || t.getDeadline() < next->getDeadline())) next = &t;
+  if (!next) return;
+
+  Clock::advanceTo(next->getDeadline());
+  const uint64_t start = Clock::nanos();
+  Clock::run();
+  next->fire(start);
+  Clock::hold();
+
+  if (next == &timers[MF_TIMER_STEP]) {
+    // A miss means the ISR was still running when its next compare match came around
+    const uint64_t end = Clock::nanos(), deadline = next->getDeadline();
+    stepper_isr.add(end - start);
+    if (end > deadline) {
+      deadline_misses++;
+      NOLESS(max_late_ns, end - deadline);
+    }
+  }
+}
+
+void PlannerBenchmark::idle() {
+  feed();
+  service_timers();
+
+  if (end_of_file && !usb_serial.receive_buffer.available() && !queue.has_commands_queued() && !planner.busy()
+    && TERN1(HAS_SHAPING, stepper.shaping_idle())
+  ) {
+    report();
+    exit(check_position() ? 0 : 1);
+  }
+}
+
+#if IS_KINEMATIC
+
+  static double ns_since(const std::chrono::steady_clock::time_point &start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  // Time the inverse kinematics alone on segments of a circle around the
+  // bed center, one at a time and batched, keeping the best of a few trials
+  static void report_kinematics() {
+    constexpr uint8_t points = 64, trials = 8;
+    constexpr uint32_t passes = 4000;
+    static xyze_pos_t raw[points];
+    static abce_pos_t abce[points];
+    LOOP_L_N(i, points) {
+      const float a = RADIANS(i * 360.0f / points);
+      raw[i] = current_position;
+      raw[i].x = X_CENTER + 10 * cos(a);
+      raw[i].y = Y_CENTER + 10 * sin(a);
+    }
+
+    double single_ns = 1e9, batch_ns = 1e9;
+    UNUSED(batch_ns);
+    LOOP_L_N(t, trials) {
+      auto start = std::chrono::steady_clock::now();
+      for (uint32_t n = passes; n--;)
+        LOOP_L_N(i, points) { inverse_kinematics(raw[i]); abce[i] = delta; }
+      NOMORE(single_ns, ns_since(start) / (passes * points));
+
+      #ifdef KINEMATIC_SEGMENT_BATCH
+        start = std::chrono::steady_clock::now();
+        for (uint32_t n = passes; n--;)
+          for (uint8_t i = 0; i < points; i += KINEMATIC_SEGMENT_BATCH)
+            inverse_kinematics(&raw[i], &abce[i], _MIN(points - i, KINEMATIC_SEGMENT_BATCH));
+        NOMORE(batch_ns, ns_since(start) / (passes * points));
+      #endif
+    }
+
+    printf("  Inverse kinematics   : %.1f ns per segment", single_ns);
+    #ifdef KINEMATIC_SEGMENT_BATCH
+      printf(", %.1f ns batched by %d", batch_ns, KINEMATIC_SEGMENT_BATCH);
+    #endif
+    printf("\n");
+  }
+
+#endif
+
+void PlannerBenchmark::report() {
+  const double host_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - host_start).count(),
+               print_s = Clock::seconds(),
+               plan_s = plan.total_ns / 1e9;
+
+  printf("Planner benchmark: %s\n", gcode_name);
+  printf("  Commands replayed    : %u\n", commands);
+  #if ENABLED(DIRECT_STEPPING)
+    printf("  Pages streamed       : %u\n", pages);
+  #endif
+  printf("  Moves planned        : %u in %.3f ms (%.0f blocks/s)\n", plan.count, plan_s * 1e3, plan_s > 0 ? plan.count / plan_s : 0.0);
+  printf("  Planner::recalculate : %u calls, %.3f ms total, %.2f us avg, %.2f us max\n",
+    recalculate.count, recalculate.total_ns / 1e6, recalculate.count ? recalculate.total_ns / 1e3 / recalculate.count : 0.0, recalculate.max_ns / 1e3);
+  printf("  Stepper ISR          : %u calls, %.2f%% load, %.2f us avg, %.2f us max\n",
+    stepper_isr.count, print_s > 0 ? 100.0 * stepper_isr.total_ns / 1e9 / print_s : 0.0,
+    stepper_isr.count ? stepper_isr.total_ns / 1e3 / stepper_isr.count : 0.0, stepper_isr.max_ns / 1e3);
+  printf("  ISR deadline misses  : %u (worst %.2f us late)\n", deadline_misses, max_late_ns / 1e3);
+  printf("  Print time           : %.3f s simulated in %.3f s\n", print_s, host_s);
+  TERN_(IS_KINEMATIC, report_kinematics());
+  // Net steps of the simulated axes, as the motors saw them
+  printf("  Axis steps           :");
+  for (uint8_t i = 0; i < COUNT(LinearAxis::numbered); i++)
+    if (LinearAxis::numbered[i]) printf(" %c:%d", "XYZE"[i], int(LinearAxis::numbered[i]->moved()));
+  printf("\n");
+  fflush(stdout);
+}
+
+// The steppers should end where the planner put them. Backlash correction steps
+// the motors without moving the planner, so the check is skipped with it. Linear
+// Advance may end with some pressure still held, which leaves E ahead by as much.
+bool PlannerBenchmark::check_position() {
+  #if DISABLED(BACKLASH_COMPENSATION)
+    bool ok = true;
+    LOOP_LOGICAL_AXES(i) {
+      int32_t stepped = stepper.position(AxisEnum(i));
+      #if ENABLED(LIN_ADVANCE)
+        if (i == E_AXIS) stepped -= Stepper::LA_current_adv_steps;
+      #endif
+      const int32_t planned = planner.position[i];
+      if (stepped != planned) {
+        printf("  Position mismatch    : %c stepped %d, planned %d\n", axis_codes[i], int(stepped), int(planned));
+        ok = false;
+      }
+    }
+    fflush(stdout);
+    return ok;
+  #else
+    return true;
+  #endif
+}
+
+#endif // PLANNER_BENCHMARK
+#endif // __PLAT_LINUX__
@@ -0,0 +1,86 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Planner replay benchmark
+ *
+ * Replays a G-code file through the real planner and stepper code as fast
+ * as the host can go. The stepper and temperature timers run in virtual
+ * time (see Clock::setVirtual) so the result doesn't depend on host load:
+ * time only advances to the next timer event, or while an ISR is running.
+ *
+ * Build with the 'linux_native_benchmark' environment and run:
+ *   program <file.gcode> [time_multiplier] [step_trace.bin]
+ *
+ * The time multiplier scales the measured ISR cost to emulate a slower MCU.
+ * A step trace file records every step (see hardware/StepTrace.h).
+ *
+ * DELTA, SCARA, and POLARGRAPH also time the inverse kinematics on their own,
+ * one segment at a time and with KINEMATIC_SEGMENT_BATCH.
+ *
+ * Run 'program --self-test' to check the planner's fixed-point and fast math
+ * against the float math it replaces (see self_test.cpp). The exit status is
+ * the number of failed checks.
+ */
+
+#include <stdint.h>
+#include <chrono>
+
+class PlannerBenchmark {
+public:
+  struct Stat {
+    uint32_t count;
+    uint64_t total_ns, max_ns;
+    void add(const uint64_t ns) { count++; total_ns += ns; if (ns > max_ns) max_ns = ns; }
+  };
+
+  // Scoped host-time measurement of a planner function
+  class Probe {
+  public:
+    Probe(Stat &s) : stat(s), start(std::chrono::steady_clock::now()) {}
+    ~Probe() { stat.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()); }
+  private:
+    Stat &stat;
+    const std::chrono::steady_clock::time_point start;
+  };
+
+  static Stat plan,         // Planner::_buffer_steps, not counting the wait for a free block
+              recalculate,  // Planner::recalculate
+              stepper_isr;  // Stepper ISR in virtual time, scaled by the time multiplier
+
+  static bool open(const char * const filename);
+  static void idle();
+  static int self_test();
+
+private:
+  static void feed();
+  static void service_timers();
+  static void report();
+  static bool check_position();
+
+  // Self-tests, in self_test.cpp
+  static bool test_trapezoids();
+  static bool test_junctions();
+  static bool test_linear_advance();
+  static bool test_bilinear_patches();
+};
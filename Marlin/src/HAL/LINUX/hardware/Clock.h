@@ -45,6 +45,7 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
+    if (Clock::virtual_time) return Clock::virtual_nanos + (Clock::virtual_running ? Clock::hostNanos() - Clock::virtual_mark : 0) * Clock::time_multiplier;
     auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
     return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
   }
@@ -62,18 +63,22 @@ public:
   }
 
   static void delayCycles(uint64_t cycles) {
+    if (Clock::virtual_time) return Clock::advance((1000000000L / frequency) * cycles);
     std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
   }
 
   static void delayMicros(uint64_t micros) {
+    if (Clock::virtual_time) return Clock::advance(micros * 1000);
     std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
   }
 
   static void delayMillis(uint64_t millis) {
+    if (Clock::virtual_time) return Clock::advance(millis * 1000000);
     std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
   }
 
   static void delaySeconds(double secs) {
+    if (Clock::virtual_time) return Clock::advance(secs * 1000000000.0);
     std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
   }
 
@@ -82,8 +87,48 @@ public:
     Clock::time_multiplier = tm;
   }
 
+  /**
+   * Virtual time, used by the planner benchmark to replay at full host speed.
+   * Time stands still until advance() jumps it forward, except between
+   * run() and hold(), where it follows the host clock scaled by the time
+   * multiplier (i.e., a multiplier of 10 emulates a CPU 10x slower).
+   */
+  static void setVirtual(const bool v) {
+    Clock::virtual_nanos = Clock::nanos();
+    Clock::virtual_running = false;
+    Clock::virtual_time = v;
+  }
+
+  static bool isVirtual() { return Clock::virtual_time; }
+  static bool isRunning() { return Clock::virtual_running; }
+
+  static void advance(uint64_t ns) {
+    Clock::virtual_nanos += ns;
+  }
+
+  static void advanceTo(uint64_t ns) {
+    if (ns > Clock::virtual_nanos) Clock::virtual_nanos = ns;
+  }
+
+  static void run() {
+    Clock::virtual_mark = Clock::hostNanos();
+    Clock::virtual_running = true;
+  }
+
+  static void hold() {
+    Clock::virtual_nanos = Clock::nanos();
+    Clock::virtual_running = false;
+  }
+
 private:
+  static uint64_t hostNanos() {
+    return std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  }
+
   static std::chrono::nanoseconds startup;
   static uint32_t frequency;
   static double time_multiplier;
+
+  static bool virtual_time, virtual_running;
+  static uint64_t virtual_nanos, virtual_mark;
 };
@@ -25,24 +25,31 @@
 #include <stdio.h>
 #include "Clock.h"
 #include "LinearAxis.h"
+#include "StepTrace.h"
 
-LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max) {
+LinearAxis *LinearAxis::numbered[4];
+
+LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max, uint8_t trace_axis) {
   enable_pin = enable;
   dir_pin = dir;
   step_pin = step;
   min_pin = end_min;
   max_pin = end_max;
+  this->trace_axis = trace_axis;
 
   min_position = 50;
   max_position = (200*80) + min_position;
   position = rand() % ((max_position - 40) - min_position) + (min_position + 20);
+  start_position = position;
   last_update = Clock::nanos();
+  if (trace_axis < COUNT(numbered)) numbered[trace_axis] = this;
 
   Gpio::attachPeripheral(step_pin, this);
 
 }
 
 LinearAxis::~LinearAxis() {
+  if (trace_axis < COUNT(numbered) && numbered[trace_axis] == this) numbered[trace_axis] = nullptr;
 
 }
 
@@ -55,6 +62,7 @@ void LinearAxis::interrupt(GpioEvent ev) {
     if (ev.event == GpioEvent::RISE) {
       last_update = ev.timestamp;
       position += -1 + 2 * Gpio::pin_map[dir_pin].value;
+      if (StepTrace::active()) StepTrace::step(trace_axis, Gpio::pin_map[dir_pin].value, ev.timestamp);
       Gpio::pin_map[min_pin].value = (position < min_position);
       //Gpio::pin_map[max_pin].value = (position > max_position);
       //if (position < min_position) printf("axis(%d) endstop : pos: %d, mm: %f, min: %d\n", step_pin, position, position / 80.0, Gpio::pin_map[min_pin].value);
@@ -26,7 +26,7 @@
 
 class LinearAxis: public Peripheral {
 public:
-  LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max);
+  LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max, uint8_t trace_axis);
   virtual ~LinearAxis();
   void update();
   void interrupt(GpioEvent ev);
@@ -36,8 +36,13 @@ public:
   pin_type step_pin;
   pin_type min_pin;
   pin_type max_pin;
+  uint8_t trace_axis; // Axis number in the step trace
+
+  static LinearAxis *numbered[4]; // By axis number, for reports
+  int32_t moved() const { return position - start_position; }
 
   int32_t position;
+  int32_t start_position;
   int32_t min_position;
   int32_t max_position;
   uint64_t last_update;
@@ -0,0 +1,73 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <stdlib.h>
+#include "StepTrace.h"
+
+FILE *StepTrace::file = nullptr;
+uint64_t StepTrace::buffer[StepTrace::BUFFER_SIZE];
+std::atomic<uint32_t> StepTrace::head(0), StepTrace::tail(0);
+uint64_t StepTrace::dropped = 0;
+std::mutex StepTrace::write_lock;
+
+bool StepTrace::open(const char * const filename) {
+  file = fopen(filename, "wb");
+  if (!file) return false;
+  const char magic[4] = { 'M', 'S', 'T', 'P' };
+  const uint16_t version = 1, size = sizeof(buffer[0]);
+  fwrite(magic, sizeof(magic), 1, file);
+  fwrite(&version, sizeof(version), 1, file);
+  fwrite(&size, sizeof(size), 1, file);
+  fwrite(&dropped, sizeof(dropped), 1, file);
+  atexit(close);  // The benchmark ends with exit()
+  return true;
+}
+
+void StepTrace::flush() {
+  std::lock_guard<std::mutex> lock(write_lock);
+  if (!file) return;
+  const uint32_t h = head.load(std::memory_order_acquire);
+  uint32_t t = tail.load(std::memory_order_relaxed);
+  while (t != h) {
+    // Up to the end of the ring, then from the start
+    const uint32_t i = t & (BUFFER_SIZE - 1), n = h - t < BUFFER_SIZE - i ? h - t : BUFFER_SIZE - i;
+    fwrite(&buffer[i], sizeof(buffer[0]), n, file);
+    t += n;
+    tail.store(t, std::memory_order_release);
+  }
+}
+
+void StepTrace::close() {
+  flush();
+  std::lock_guard<std::mutex> lock(write_lock);
+  if (!file) return;
+  if (dropped) {
+    fprintf(stderr, "Step trace: %llu steps dropped\n", (unsigned long long)dropped);
+    fseek(file, 8, SEEK_SET);
+    fwrite(&dropped, sizeof(dropped), 1, file);
+  }
+  fclose(file);
+  file = nullptr;
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,85 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Binary step trace
+ *
+ * Records every step of the simulated axes with its Clock::nanos() timestamp,
+ * for offline analysis with buildroot/share/scripts/stepTrace.py.
+ *
+ * The file is a 16 byte header followed by one 8 byte record per step:
+ *
+ *   char     magic[4]   "MSTP"
+ *   uint16_t version    1
+ *   uint16_t size       8, the record size
+ *   uint64_t dropped    Steps lost to a full buffer (only in real time)
+ *
+ *   uint64_t record     (nanos << 4) | (dir << 3) | axis
+ *
+ * All little-endian. The Stepper ISR is the only producer, so steps go into a
+ * lock-free ring and the simulation thread writes them out in blocks. In real
+ * time the ISR runs from a signal handler, which can't wait, so a full ring
+ * drops steps and counts them. In virtual time the ISR waits for room instead,
+ * with the clock stopped.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <mutex>
+
+#include "Clock.h"
+
+class StepTrace {
+public:
+  static bool open(const char * const filename);
+  static void close();
+
+  // Write out the steps recorded so far
+  static void flush();
+
+  static bool active() { return file != nullptr; }
+
+  static void step(const uint8_t axis, const bool dir, const uint64_t nanos) {
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= BUFFER_SIZE) {
+      if (!Clock::isVirtual()) { dropped++; return; }
+      // Wait for the simulation thread with virtual time stopped, so the ISR isn't seen to take longer
+      const bool running = Clock::isRunning();
+      if (running) Clock::hold();
+      while (h - tail.load(std::memory_order_acquire) >= BUFFER_SIZE) std::this_thread::yield();
+      if (running) Clock::run();
+    }
+    buffer[h & (BUFFER_SIZE - 1)] = (nanos << 4) | (uint64_t(dir) << 3) | (axis & 0x7);
+    head.store(h + 1, std::memory_order_release);
+  }
+
+private:
+  static constexpr uint32_t BUFFER_SIZE = 0x10000; // Records, a power of 2
+
+  static FILE *file;
+  static uint64_t buffer[BUFFER_SIZE];
+  static std::atomic<uint32_t> head, tail;
+  static uint64_t dropped;
+  static std::mutex write_lock;   // Between the simulation thread and close() at exit
+};
@@ -48,6 +48,10 @@ public:
   uint32_t getOverruns() {return overruns;}
   uint32_t getAvgError() {return avg_error;}
 
+  // Virtual timer support for the planner benchmark (see Clock::setVirtual)
+  uint64_t getDeadline() { return start_time + uint64_t(compare) * (1000000000ULL / frequency); }
+  void fire(uint64_t when) { start_time = when; cbfn(); }
+
   intptr_t getID() {
     return (*(intptr_t*)timerid);
   }
@@ -29,8 +29,14 @@
 #include "hardware/IOLoggerCSV.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
+#include "hardware/StepTrace.h"
+
+#if ENABLED(DIRECT_STEPPING)
+  #include "../../feature/direct_stepping.h"
+#endif
 
 #include <stdio.h>
+#include <unistd.h>
 #include <stdarg.h>
 #include <thread>
 #include <iostream>
@@ -41,21 +47,29 @@ extern void loop();
 
 // simple stdout / stdin implementation for fake serial port
 void write_serial_thread() {
+  // The benchmark report goes to stdout, so keep the firmware chatter apart
+  FILE * const out = TERN(PLANNER_BENCHMARK, stderr, stdout);
   for (;;) {
     for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
-      fputc(usb_serial.transmit_buffer.read(), stdout);
+      fputc(usb_serial.transmit_buffer.read(), out);
     }
     std::this_thread::yield();
   }
 }
 
 void read_serial_thread() {
-  char buffer[255] = {};
+  uint8_t buffer[254];
   for (;;) {
-    std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
-    if (fgets(buffer, len, stdin))
-      for (std::size_t i = 0; i < strlen(buffer); i++)
-        usb_serial.receive_buffer.write(buffer[i]);
+    // Raw reads, since direct stepping pages are binary
+    const std::size_t len = _MIN(usb_serial.receive_buffer.free(), sizeof(buffer));
+    const ssize_t count = len ? read(STDIN_FILENO, buffer, len) : 0;
+    for (ssize_t i = 0; i < count; i++) {
+      // Pages go to the page manager as they arrive, like the serial RX ISR
+      #if ENABLED(DIRECT_STEPPING)
+        if (page_manager.maybe_store_rxd_char(buffer[i])) continue;
+      #endif
+      usb_serial.receive_buffer.write(buffer[i]);
+    }
     std::this_thread::yield();
   }
 }
@@ -63,10 +77,10 @@ void read_serial_thread() {
 void simulation_loop() {
   Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
   Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
-  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
-  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
-  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
-  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN, 0);
+  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN, 1);
+  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN, 2);
+  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC, 3);
 
   #ifdef GPIO_LOGGING
     IOLoggerCSV logger("all_gpio_log.csv");
@@ -101,13 +115,38 @@ void simulation_loop() {
       logger.flush();
     #endif
 
+    StepTrace::flush();
+
     std::this_thread::yield();
   }
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+  #if ENABLED(PLANNER_BENCHMARK)
+    if (argc > 1 && !strcmp(argv[1], "--self-test")) return PlannerBenchmark::self_test();
+
+    // G-code comes from the file given on the command line, fed in by the benchmark
+    if (argc < 2 || !PlannerBenchmark::open(argv[1])) {
+      fprintf(stderr, "Usage: %s <file.gcode> [time_multiplier] [step_trace.bin]\n       %s --self-test\n", argv[0], argv[0]);
+      return 1;
+    }
+    Clock::setTimeMultiplier(argc > 2 ? atof(argv[2]) : 1.0);
+    Clock::setVirtual(true);
+    const char * const trace_file = argc > 3 ? argv[3] : nullptr;
+  #else
+    const char * const trace_file = argc > 1 ? argv[1] : nullptr;
+  #endif
+
+  // Steps of all axes, for buildroot/share/scripts/stepTrace.py
+  if (trace_file && !StepTrace::open(trace_file)) {
+    fprintf(stderr, "Can't open step trace %s\n", trace_file);
+    return 1;
+  }
+
   std::thread write_serial (write_serial_thread);
-  std::thread read_serial (read_serial_thread);
+  #if DISABLED(PLANNER_BENCHMARK)
+    std::thread read_serial (read_serial_thread);
+  #endif
 
   #ifdef MYSERIAL1
     MYSERIAL1.begin(BAUDRATE);
@@ -116,7 +155,9 @@ int main() {
   #endif
 
   Clock::setFrequency(F_CPU);
-  Clock::setTimeMultiplier(1.0); // some testing at 10x
+  #if DISABLED(PLANNER_BENCHMARK)
+    Clock::setTimeMultiplier(1.0); // some testing at 10x
+  #endif
 
   HAL_timer_init();
 
@@ -132,7 +173,7 @@ int main() {
 
   simulation.join();
   write_serial.join();
-  read_serial.join();
+  IF_DISABLED(PLANNER_BENCHMARK, read_serial.join());
 }
 
 #endif // __PLAT_LINUX__
@@ -0,0 +1,330 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+/**
+ * Planner self-test
+ *
+ * Runs the firmware's own fixed-point and fast math on random inputs and
+ * compares it with the float math it replaces and with exact math done in
+ * integers or doubles. Each test prints its worst case and whether it stayed
+ * within the bound given in the code it tests.
+ */
+
+#include "benchmark.h"
+#include "../../module/planner.h"
+#if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+  #include "../../feature/bedlevel/bedlevel.h"
+#endif
+
+#include <math.h>
+#include <stdarg.h>
+
+// Repeatable random numbers (xorshift32)
+static uint32_t random_state = 2463534242UL;
+static _UNUSED uint32_t random32() {
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return random_state;
+}
+
+// Spread over all magnitudes up to 'bits' bits, never zero
+static _UNUSED uint32_t random_bits(const uint8_t bits) {
+  const uint32_t v = random32() >> (31 - random32() % bits);
+  return v ? v : 1;
+}
+
+// Print a test's line of results, ending with whether it passed
+static _UNUSED bool result(const bool passed, const char * const fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+  printf(" : %s\n", passed ? "passed" : "FAILED");
+  return passed;
+}
+
+#if ENABLED(FIXED_POINT_TRAPEZOIDS)
+
+  // floor(n / d) for any sign of n, d > 0
+  static int64_t floor_div(const int64_t n, const int64_t d) { return n >= 0 ? n / d : -((d - 1 - n) / d); }
+
+  /**
+   * The integer trapezoid step counts must be the exactly rounded values for
+   * blocks under 2^24 steps and rates under 2^19. The float path they replace
+   * is shown for comparison. It rounds some counts the wrong way.
+   */
+  bool PlannerBenchmark::test_trapezoids() {
+    constexpr uint32_t cases = 500000;
+    uint32_t float_differs = 0, fixed_wrong = 0;
+    int64_t float_worst = 0;
+    block_t block{};
+
+    // A float step count next to the exact one, if both are within the block
+    auto compare_float = [&](const float f, const int64_t exact) {
+      const int64_t steps = block.step_event_count;
+      if (exact < 0 || exact > steps || !(f > -1 && f <= steps)) return;
+      const int64_t diff = int64_t(f) - exact;
+      if (diff) { float_differs++; NOLESS(float_worst, ABS(diff)); }
+    };
+
+    for (uint32_t n = cases; n--;) {
+      block.acceleration_steps_per_s2 = random_bits(24);
+      block.step_event_count = random_bits(24);
+      Planner::set_acceleration_inverse(&block);
+
+      const uint32_t rate1 = random_bits(19), rate2 = random_bits(19);
+      const int64_t a = block.acceleration_steps_per_s2, steps = block.step_event_count,
+                    m = int64_t(sq(uint64_t(rate2))) - int64_t(sq(uint64_t(rate1))), // rate2² - rate1²
+                    accel_exact = rate2 > rate1 ? -floor_div(-m, 2 * a) : 0,           // CEIL(m / 2a)
+                    decel_exact = rate1 > rate2 ? floor_div(-m, 2 * a) : 0,            // FLOOR(-m / 2a)
+                    cross_exact = -floor_div(-(2 * a * steps + m), 4 * a);            // CEIL(S / 2 + m / 4a)
+
+      if (Planner::estimate_acceleration_steps(&block, rate1, rate2) != _MIN(accel_exact, steps + 1)) fixed_wrong++;
+      if (Planner::estimate_deceleration_steps(&block, rate1, rate2) != _MIN(decel_exact, steps + 1)) fixed_wrong++;
+      if (Planner::intersection_steps(&block, rate1, rate2) != constrain(cross_exact, 0, steps)) fixed_wrong++;
+
+      // calculate_trapezoid_for_block() without FIXED_POINT_TRAPEZOIDS
+      if (rate2 > rate1) compare_float(CEIL(Planner::estimate_acceleration_distance(rate1, rate2, a)), accel_exact);
+      if (rate1 > rate2) compare_float(FLOOR(Planner::estimate_acceleration_distance(rate1, rate2, -a)), decel_exact);
+      compare_float(CEIL(Planner::intersection_distance(rate1, rate2, a, steps)), cross_exact);
+    }
+
+    return result(!fixed_wrong, "  Trapezoid steps      : %u blocks, %u fixed-point counts inexact (float: %u off by up to %d)",
+      cases, fixed_wrong, float_differs, int(float_worst));
+  }
+
+#endif // FIXED_POINT_TRAPEZOIDS
+
+#if HAS_JUNCTION_DEVIATION
+
+  static double gauss() { return sqrt(-2 * log((random32() + 1.0) / 4294967297.0)) * cos(2 * M_PI * random32() / 4294967296.0); }
+
+  /**
+   * Planner::junction_speed_sqr() against exact math for random XYZE junctions,
+   * by deflection angle. Slicers split arcs into segments that turn by well
+   * under a degree, so those angles get bands of their own.
+   *
+   *   speed² = a * JD * sin(θ/2) / (1 - sin(θ/2))   θ = angle between the segments
+   *
+   * The planner caps the speed below a deflection of 0.08°, so the test starts at
+   * 0.1°. With JD_HANDLE_SMALL_SEGMENTS a short block turning by up to 45° is limited
+   * to millimeters * a / deflection. The deflection behind that limit must be
+   * within the error given for the approximation in planner.cpp.
+   */
+  bool PlannerBenchmark::test_junctions() {
+    constexpr uint32_t cases = 60000;
+    constexpr float accels[] = { 500, 1000, 3000 }, deviations[] = { 0.01f, 0.02f, 0.05f };
+    static const struct { float from, to, max_error; } bands[] = {
+      #if ENABLED(JD_FAST_MATH)
+        // Within the error of fast_rsqrt() at every angle
+        { 0.1, 1, 0.005 }, { 1, 10, 0.005 }, { 10, 45, 0.005 }, { 45, 90, 0.005 }, { 90, 179.9, 0.005 }
+      #else
+        // The float (1 - sin) cancels for nearly straight junctions, and the cosine near a reversal
+        { 0.1, 1, 0.2 }, { 1, 10, 0.005 }, { 10, 45, 0.0001 }, { 45, 90, 0.0001 }, { 90, 179.9, 0.02 }
+      #endif
+    };
+    constexpr uint8_t band_count = COUNT(bands);
+    double worst[band_count] = { 0 };
+
+    #if ENABLED(JD_HANDLE_SMALL_SEGMENTS)
+      constexpr double theta_bound = TERN(JD_FAST_MATH, 0.0005, TERN(JD_USE_LOOKUP_TABLE, 0.01, 0.033));
+      double theta_worst = 0;
+    #endif
+
+    // Let the block's acceleration through on every axis
+    LOOP_LOGICAL_AXES(i) Planner::settings.max_acceleration_mm_per_s2[i] = 1000000;
+
+    for (uint32_t n = 0; n < cases; n++) {
+      const uint8_t b = n % band_count;
+      const double deflection = RADIANS(bands[b].from * exp(log(bands[b].to / bands[b].from) * random32() / 4294967296.0));
+
+      // A direction with a little Z and E, as when printing
+      double p[4] = { gauss(), gauss(), 0.05 * gauss(), 0.01 + 0.04 * random32() / 4294967296.0 }, q[4], u[4];
+      LOOP_L_N(i, 4) q[i] = gauss();
+      double pp = 0, pq = 0, qq = 0;
+      LOOP_L_N(i, 4) pp += sq(p[i]);
+      LOOP_L_N(i, 4) p[i] /= sqrt(pp);
+      LOOP_L_N(i, 4) pq += p[i] * q[i];
+      LOOP_L_N(i, 4) { q[i] -= pq * p[i]; qq += sq(q[i]); }
+      // Turn p by the deflection, toward q
+      LOOP_L_N(i, 4) u[i] = p[i] * cos(deflection) + q[i] / sqrt(qq) * sin(deflection);
+
+      xyze_float_t prev_unit_vec, unit_vec;
+      prev_unit_vec.reset();
+      unit_vec.reset();
+      prev_unit_vec.set(p[0], p[1], p[2]);
+      unit_vec.set(u[0], u[1], u[2]);
+      TERN_(HAS_EXTRUDERS, prev_unit_vec.e = p[3]; unit_vec.e = u[3]);
+
+      // The angle between the float vectors, without cancellation
+      double d2 = 0, s2 = 0;
+      LOOP_LOGICAL_AXES(i) { d2 += sq(double(unit_vec[i]) - prev_unit_vec[i]); s2 += sq(double(unit_vec[i]) + prev_unit_vec[i]); }
+      const double theta = 2 * atan2(sqrt(d2), sqrt(s2)),
+                   sin_theta_d2 = cos(theta / 2), one_minus_sin = 2 * sq(sin(theta / 4));
+
+      const float a = accels[random32() % COUNT(accels)];
+      Planner::junction_deviation_mm = deviations[random32() % COUNT(deviations)];
+      const double exact = a * Planner::junction_deviation_mm * sin_theta_d2 / one_minus_sin;
+      NOLESS(worst[b], ABS(Planner::junction_speed_sqr(prev_unit_vec, unit_vec, a, 1) / exact - 1));
+
+      #if ENABLED(JD_HANDLE_SMALL_SEGMENTS)
+        // A block this short is always held to its arc limit
+        if (theta < RADIANS(44.9)) {
+          constexpr float mm = 0.001f;
+          NOLESS(theta_worst, ABS(mm * a / Planner::junction_speed_sqr(prev_unit_vec, unit_vec, a, mm) - theta));
+        }
+      #endif
+    }
+
+    bool passed = true;
+    LOOP_L_N(b, band_count) {
+      passed &= result(worst[b] <= bands[b].max_error, "  Junction %5.1f-%5.1f° : worst speed² error %.4f%% (bound %.2f%%)",
+        bands[b].from, bands[b].to, 100 * worst[b], 100 * bands[b].max_error);
+    }
+    #if ENABLED(JD_HANDLE_SMALL_SEGMENTS)
+      passed &= result(theta_worst <= theta_bound, "  Small segment angle  : worst error %.5f rad (bound %.4f)", theta_worst, theta_bound);
+    #endif
+    return passed;
+  }
+
+#endif // HAS_JUNCTION_DEVIATION
+
+#if ENABLED(LIN_ADVANCE)
+
+  /**
+   * The Q24 advance factor set by Planner::set_advance_factor() against exact
+   * math for random print moves. Advance steps must be within rounding of the
+   * exact K * E step rate, and advance_speed within a tick of the exact interval,
+   * which it truncates.
+   * The float path it replaces is shown for comparison. It truncated the steps.
+   */
+  bool PlannerBenchmark::test_linear_advance() {
+    constexpr uint32_t cases = 500000;
+    constexpr double max_steps_error = 0.51, max_speed_error = 1.01;
+    uint32_t float_differs = 0;
+    double steps_worst = 0, speed_worst = 0;
+    block_t block{};
+
+    for (uint32_t n = cases; n--;) {
+      block.step_event_count = 100 + random32() % 40000;
+      block.nominal_rate = 500 + random32() % 100000;
+      const uint32_t esteps = 1 + random32() % block.step_event_count,
+                     accel = 1000 + random32() % 2000000;
+      const float k = (1 + random32() % 2000) * 0.001f;
+      const double factor = double(k) * esteps / block.step_event_count;
+      if (factor * block.nominal_rate > 65535 || (STEPPER_TIMER_RATE) / (factor * accel) > 65535) continue;
+
+      Planner::set_advance_factor(&block, k, esteps, accel);
+
+      // The steps at the nominal rate and at a lower exit rate
+      const uint32_t exit_rate = uint64_t(block.nominal_rate) * (random32() >> 16) >> 16;
+      const double exact = factor * block.nominal_rate;
+      NOLESS(steps_worst, ABS(block.max_adv_steps - exact));
+      NOLESS(steps_worst, ABS(Planner::advance_steps(&block, exit_rate) - factor * exit_rate));
+      NOLESS(speed_worst, ABS(block.advance_speed - (STEPPER_TIMER_RATE) / (factor * accel)));
+
+      // _populate_block() without the Q24 factor
+      if (uint16_t(k * esteps / block.step_event_count * block.nominal_rate) != LROUND(exact)) float_differs++;
+    }
+
+    bool passed = result(steps_worst <= max_steps_error, "  Advance steps        : worst error %.4f steps (bound %.2f, float: %u truncated)",
+      steps_worst, max_steps_error, float_differs);
+    passed &= result(speed_worst <= max_speed_error, "  Advance speed        : worst error %.4f ticks (bound %.2f)", speed_worst, max_speed_error);
+    return passed;
+  }
+
+#endif // LIN_ADVANCE
+
+#if ENABLED(ABL_BILINEAR_PATCHES) && DISABLED(ABL_BILINEAR_SUBDIVISION)
+
+  /**
+   * bilinear_z_offset() from the patch table against the bilinear surface worked
+   * out in doubles, for random meshes looked up on and around the grid. Beyond the
+   * grid the surface keeps the edge height, or extends the edge cells with
+   * EXTRAPOLATE_BEYOND_GRID. The float terms are within float rounding. The integer
+   * terms are each rounded to 1µm, and the products of the lookup add their own.
+   * The test can't see the subdivided grid, so it doesn't run with ABL_BILINEAR_SUBDIVISION.
+   */
+  bool PlannerBenchmark::test_bilinear_patches() {
+    constexpr uint32_t meshes = 2000, points = 500;
+    constexpr double max_error_um = TERN(ABL_BILINEAR_FIXED_POINT, 3.5, 0.05);
+    auto uniform = [](const double lo, const double hi) { return lo + (hi - lo) * random32() / 4294967296.0; };
+    double worst = 0;
+
+    for (uint32_t m = meshes; m--;) {
+      bilinear_start.set(uniform(-20, 40), uniform(-20, 40));
+      bilinear_grid_spacing.set(uniform(10, 300) / ((GRID_MAX_POINTS_X) - 1), uniform(10, 300) / ((GRID_MAX_POINTS_Y) - 1));
+      const double tilt_x = uniform(-0.004, 0.004), tilt_y = uniform(-0.004, 0.004);
+      GRID_LOOP(x, y) z_values[x][y] = tilt_x * x * bilinear_grid_spacing.x + tilt_y * y * bilinear_grid_spacing.y + uniform(-0.3, 0.3);
+      refresh_bed_level();
+
+      for (uint32_t n = points; n--;) {
+        // About a third of the points lie beyond the grid
+        const xy_pos_t raw = {
+          float(bilinear_start.x + uniform(-0.1, 1.1) * bilinear_grid_spacing.x * ((GRID_MAX_POINTS_X) - 1)),
+          float(bilinear_start.y + uniform(-0.1, 1.1) * bilinear_grid_spacing.y * ((GRID_MAX_POINTS_Y) - 1))
+        };
+
+        // The cell and the place in it, with the edge cells extending beyond the grid
+        double u = (double(raw.x) - bilinear_start.x) / bilinear_grid_spacing.x,
+               v = (double(raw.y) - bilinear_start.y) / bilinear_grid_spacing.y;
+        #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
+          LIMIT(u, 0, (GRID_MAX_POINTS_X) - 1);
+          LIMIT(v, 0, (GRID_MAX_POINTS_Y) - 1);
+        #endif
+        const int gx = constrain(int(floor(u)), 0, (GRID_MAX_POINTS_X) - 2),
+                  gy = constrain(int(floor(v)), 0, (GRID_MAX_POINTS_Y) - 2);
+        u -= gx;
+        v -= gy;
+        const double exact = z_values[gx][gy] * (1 - u) * (1 - v) + z_values[gx + 1][gy] * u * (1 - v)
+                           + z_values[gx][gy + 1] * (1 - u) * v + z_values[gx + 1][gy + 1] * u * v;
+
+        NOLESS(worst, ABS(bilinear_z_offset(raw) - exact) * 1000);
+      }
+    }
+
+    return result(worst <= max_error_um, "  Bilinear patches     : worst error %.4f µm (bound %.2f)", worst, max_error_um);
+  }
+
+#endif // ABL_BILINEAR_PATCHES && !ABL_BILINEAR_SUBDIVISION
+
+int PlannerBenchmark::self_test() {
+  int failed = 0;
+  printf("Planner self-test\n");
+  TERN_(FIXED_POINT_TRAPEZOIDS, failed += !test_trapezoids());
+  TERN_(HAS_JUNCTION_DEVIATION, failed += !test_junctions());
+  TERN_(LIN_ADVANCE, failed += !test_linear_advance());
+  #if ENABLED(ABL_BILINEAR_PATCHES) && DISABLED(ABL_BILINEAR_SUBDIVISION)
+    failed += !test_bilinear_patches();
+  #endif
+  printf("%s\n", failed ? "Self-test FAILED" : "Self-test passed");
+  return failed;
+}
+
+#endif // PLANNER_BENCHMARK
+#endif // __PLAT_LINUX__
@@ -190,6 +190,10 @@
   #include "feature/runout.h"
 #endif
 
+#if ENABLED(BUFFER_ARENA)
+  #include "feature/buffer_arena.h"
+#endif
+
 #if EITHER(PROBE_TARE, HAS_Z_SERVO_PROBE)
   #include "module/probe.h"
 #endif
@@ -1197,6 +1201,10 @@ void setup() {
 
   TERN_(DYNAMIC_VECTORTABLE, hook_cpu_exceptions()); // If supported, install Marlin exception handlers at runtime
 
+  #if ENABLED(BUFFER_ARENA)
+    SETUP_RUN(buffer_arena.init());   // Point the planner and command queue into the arena
+  #endif
+
   SETUP_RUN(HAL_init());
 
   // Init and disable SPI thermocouples; this is still needed
@@ -1266,7 +1274,7 @@ void setup() {
     );
   #endif
   SERIAL_ECHO_MSG(" Compiled: " __DATE__);
-  SERIAL_ECHO_MSG(STR_FREE_MEMORY, freeMemory(), STR_PLANNER_BUFFER_BYTES, sizeof(block_t) * (BLOCK_BUFFER_SIZE));
+  SERIAL_ECHO_MSG(STR_FREE_MEMORY, freeMemory(), STR_PLANNER_BUFFER_BYTES, sizeof(block_t) * TERN(BUFFER_ARENA, planner.block_buffer_mask + 1, BLOCK_BUFFER_SIZE));
 
   // Some HAL need precise delay adjustment
   calibrate_delay_loop();
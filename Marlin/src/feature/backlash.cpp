@@ -49,6 +49,11 @@
   xyz_uint8_t Backlash::measured_count{0};
 #endif
 
+axis_bits_t Backlash::last_direction_bits;
+#ifdef BACKLASH_SMOOTHING_MM
+  xyz_long_t Backlash::residual_error{0};
+#endif
+
 Backlash backlash;
 
 /**
@@ -61,7 +66,6 @@ Backlash backlash;
  */
 
 void Backlash::add_correction_steps(const int32_t &da, const int32_t &db, const int32_t &dc, const axis_bits_t dm, block_t * const block) {
-  static axis_bits_t last_direction_bits;
   axis_bits_t changed_dir = last_direction_bits ^ dm;
   // Ignore direction change unless steps are taken in that direction
   #if DISABLED(CORE_BACKLASH) || EITHER(MARKFORGED_XY, MARKFORGED_YX)
@@ -91,10 +95,6 @@ void Backlash::add_correction_steps(const int32_t &da, const int32_t &db, const
     // smoothing distance. Since the computation of this proportion involves a floating point
     // division, defer computation until needed.
     float segment_proportion = 0;
-
-    // Residual error carried forward across multiple segments, so correction can be applied
-    // to segments where there is no direction change.
-    static xyz_long_t residual_error{0};
   #else
     // No direction change, no correction.
     if (!changed_dir) return;
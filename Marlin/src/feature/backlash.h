@@ -71,6 +71,14 @@ public:
     return has_measurement(X_AXIS) || has_measurement(Y_AXIS) || has_measurement(Z_AXIS);
   }
 
+  // Directions of the last block, and the residual error carried forward across multiple
+  // segments so correction can be applied to segments where there is no direction change.
+  // The planner saves these to populate a block again.
+  static axis_bits_t last_direction_bits;
+  #ifdef BACKLASH_SMOOTHING_MM
+    static xyz_long_t residual_error;
+  #endif
+
   void add_correction_steps(const int32_t &da, const int32_t &db, const int32_t &dc, const axis_bits_t dm, block_t * const block);
 };
 
@@ -244,12 +244,6 @@ void print_bilinear_leveling_grid() {
   }
 #endif // ABL_BILINEAR_SUBDIVISION
 
-// Refresh after other values have been updated
-void refresh_bed_level() {
-  bilinear_grid_factor = bilinear_grid_spacing.reciprocal();
-  TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
-}
-
 #if ENABLED(ABL_BILINEAR_SUBDIVISION)
   #define ABL_BG_SPACING(A) bilinear_grid_spacing_virt.A
   #define ABL_BG_FACTOR(A)  bilinear_grid_factor_virt.A
@@ -264,6 +258,97 @@ void refresh_bed_level() {
   #define ABL_BG_GRID(X,Y)  z_values[X][Y]
 #endif
 
+#if ENABLED(ABL_BILINEAR_PATCHES)
+
+  #if ENABLED(ABL_BILINEAR_FIXED_POINT)
+    // The same terms in µm, with u and v from 0 to 65535 across the cell
+    typedef struct { int16_t a, b, c, d; } bilinear_patch_t;
+    // An unprobed (NaN) term is 0, since NaN has no integer value
+    static int16_t patch_term(const float z) { return isnan(z) ? 0 : int16_t(LROUND(constrain(z * 1000, -32767, 32767))); }
+    #define PATCH_TERM(Z) patch_term(Z)
+    static xy_float_t bilinear_cell_factor; // Cells per mm, scaled for Q16.16
+  #else
+    // Z = a + b * u + c * v + d * u * v, with u and v from 0 to 1 across the cell
+    typedef struct { float a, b, c, d; } bilinear_patch_t;
+    #define PATCH_TERM(Z) (Z)
+  #endif
+
+  static bilinear_patch_t bilinear_patches[(ABL_BG_POINTS_X) - 1][(ABL_BG_POINTS_Y) - 1];
+
+  static void bed_level_patch_refresh() {
+    #if ENABLED(ABL_BILINEAR_FIXED_POINT)
+      bilinear_cell_factor.set(ABL_BG_FACTOR(x) * 65536.0f, ABL_BG_FACTOR(y) * 65536.0f);
+    #endif
+    LOOP_L_N(x, (ABL_BG_POINTS_X) - 1)
+      LOOP_L_N(y, (ABL_BG_POINTS_Y) - 1) {
+        const float z1 = ABL_BG_GRID(x, y),     z2 = ABL_BG_GRID(x, y + 1),
+                    z3 = ABL_BG_GRID(x + 1, y), z4 = ABL_BG_GRID(x + 1, y + 1);
+        bilinear_patch_t &p = bilinear_patches[x][y];
+        p.a = PATCH_TERM(z1);
+        p.b = PATCH_TERM(z3 - z1);
+        p.c = PATCH_TERM(z2 - z1);
+        p.d = PATCH_TERM((z4 - z3) - (z2 - z1));
+      }
+  }
+
+#endif
+
+// Refresh after other values have been updated
+void refresh_bed_level() {
+  bilinear_grid_factor = bilinear_grid_spacing.reciprocal();
+  TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
+  TERN_(ABL_BILINEAR_PATCHES, bed_level_patch_refresh());
+}
+
+#if ENABLED(ABL_BILINEAR_FIXED_POINT)
+
+// Get the Z adjustment for non-linear bed leveling
+float bilinear_z_offset(const xy_pos_t &raw) {
+
+  // XY relative to the probed area, in grid cells (Q16.16)
+  int32_t u = int32_t((raw.x - bilinear_start.x) * bilinear_cell_factor.x),
+          v = int32_t((raw.y - bilinear_start.y) * bilinear_cell_factor.y);
+
+  // Beyond the grid maintain height at grid edges
+  LIMIT(u, 0, (int32_t((ABL_BG_POINTS_X) - 1) << 16) - 1);
+  LIMIT(v, 0, (int32_t((ABL_BG_POINTS_Y) - 1) << 16) - 1);
+
+  // The whole part picks the cell, the fraction is the place within it.
+  // Every product is 16 x 16 bits, which is cheap on AVR.
+  #define Q16_MUL(Z,F) ((int32_t(Z) * (F) + 0x8000) >> 16)
+  const bilinear_patch_t &p = bilinear_patches[u >> 16][v >> 16];
+  const uint16_t fu = u, fv = v;
+  const int16_t cd = p.c + int16_t(Q16_MUL(p.d, fu));
+  return (p.a + Q16_MUL(p.b, fu) + Q16_MUL(cd, fv)) * 0.001f;
+}
+
+#elif ENABLED(ABL_BILINEAR_PATCHES)
+
+// Get the Z adjustment for non-linear bed leveling
+float bilinear_z_offset(const xy_pos_t &raw) {
+
+  // XY relative to the probed area, in grid cells
+  float u = (raw.x - bilinear_start.x) * ABL_BG_FACTOR(x),
+        v = (raw.y - bilinear_start.y) * ABL_BG_FACTOR(y);
+
+  #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
+    // Beyond the grid maintain height at grid edges
+    LIMIT(u, 0, (ABL_BG_POINTS_X) - 1);
+    LIMIT(v, 0, (ABL_BG_POINTS_Y) - 1);
+  #endif
+
+  // The cell to use, keeping the edge cells beyond the grid
+  const uint8_t gx = constrain(FLOOR(u), 0, (ABL_BG_POINTS_X) - 2),
+                gy = constrain(FLOOR(v), 0, (ABL_BG_POINTS_Y) - 2);
+  u -= gx;
+  v -= gy;
+
+  const bilinear_patch_t &p = bilinear_patches[gx][gy];
+  return p.a + p.b * u + v * (p.c + p.d * u);
+}
+
+#else // !ABL_BILINEAR_PATCHES
+
 // Get the Z adjustment for non-linear bed leveling
 float bilinear_z_offset(const xy_pos_t &raw) {
 
@@ -348,6 +433,8 @@ float bilinear_z_offset(const xy_pos_t &raw) {
   return offset;
 }
 
+#endif // !ABL_BILINEAR_PATCHES
+
 #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
 
   #define CELL_INDEX(A,V) ((V - bilinear_start.A) * ABL_BG_FACTOR(A))
@@ -67,7 +67,7 @@ void set_bed_leveling_enabled(const bool enable/*=true*/) {
 
     planner.synchronize();
 
-    #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+    #if ENABLED(AUTO_BED_LEVELING_BILINEAR) && DISABLED(ABL_BILINEAR_PATCHES)
       // Force bilinear_z_offset to re-calculate next time
       const xyz_pos_t reset { -9999.999, -9999.999, 0 };
       (void)bilinear_z_offset(reset);
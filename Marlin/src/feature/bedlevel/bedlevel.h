@@ -102,4 +102,64 @@ class TemporaryBedLevelingState {
     operator const xy_int8_t&() const { return pos; }
   };
 
+  #ifdef LEVELED_MERGE_TOLERANCE
+
+    /**
+     * Buffer the pieces of a leveled move, leaving out the breaks that the Z correction doesn't need.
+     * A break is dropped while one straight line from the last buffered point passes within
+     * LEVELED_MERGE_TOLERANCE of the correction at every break dropped since. Each break narrows
+     * the range of slopes that line may take, so only the latest break has to be held back.
+     */
+    class LeveledMerge {
+      xy_pos_t from;          // The last buffered point
+      float from_z,           // The correction there
+            lo, hi;           // Slopes of a line from there that pass close enough to the breaks since
+      xyze_pos_t held;        // The latest break, kept until the next one shows whether it's needed
+      float held_z;
+      bool holding;
+
+      // Distance along the move from the last buffered point. Any measure that's linear on a line will do.
+      float dist(const xy_pos_t &pos) const { return ABS(pos.x - from.x) + ABS(pos.y - from.y); }
+
+    public:
+      LeveledMerge() : from_z(0), lo(0), hi(0), held_z(0), holding(false) { from.reset(); }
+
+      // Start from a point where the move has the given correction
+      void start(const xy_pos_t &pos, const_float_t z) { from = pos; from_z = z; holding = false; }
+
+      // Take the next break and its correction, buffering the held break if the move needs it
+      template<typename F>
+      bool add(const xyze_pos_t &pos, const_float_t z, F buffer) {
+        if (holding && !WITHIN((z - from_z) / dist(pos), lo, hi)) {
+          if (!buffer(held)) return false;
+          from = held;
+          from_z = held_z;
+          holding = false;
+        }
+        const float d = dist(pos), slope = (z - from_z) / d, margin = (LEVELED_MERGE_TOLERANCE) * 0.001f / d;
+        if (holding) {
+          NOLESS(lo, slope - margin);
+          NOMORE(hi, slope + margin);
+        }
+        else {
+          lo = slope - margin;
+          hi = slope + margin;
+        }
+        held = pos;
+        held_z = z;
+        holding = true;
+        return true;
+      }
+
+      // Buffer the held break, the end of the move
+      template<typename F>
+      bool flush(F buffer) {
+        if (!holding) return true;
+        holding = false;
+        return buffer(held);
+      }
+    };
+
+  #endif
+
 #endif
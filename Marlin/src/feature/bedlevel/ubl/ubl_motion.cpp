@@ -54,6 +54,16 @@
 
     const xy_int8_t istart = cell_indexes(start), iend = cell_indexes(end);
 
+    #ifdef LEVELED_MERGE_TOLERANCE
+      LeveledMerge merge;
+      auto buffer = [&](const xyze_pos_t &pos) { return planner.buffer_segment(pos, scaled_fr_mm_s, extruder); };
+      #define BUFFER_SEGMENT(P, Z) merge.add(P, Z, buffer)
+      #define FLUSH_SEGMENTS() merge.flush(buffer)
+    #else
+      #define BUFFER_SEGMENT(P, Z) planner.buffer_segment(P, scaled_fr_mm_s, extruder)
+      #define FLUSH_SEGMENTS() NOOP
+    #endif
+
     // A move within the same cell needs no splitting
     if (istart == iend) {
 
@@ -69,6 +79,7 @@
           // a calculated (Bi-Linear interpolation) correction.
 
           end.z += UBL_Z_RAISE_WHEN_OFF_MESH;
+          FLUSH_SEGMENTS();
           planner.buffer_segment(end, scaled_fr_mm_s, extruder);
           current_position = destination;
           return;
@@ -86,12 +97,24 @@
 
       // Undefined parts of the Mesh in z_values[][] are NAN.
       // Replace NAN corrections with 0.0 to prevent NAN propagation.
-      if (!isnan(z0)) end.z += z0;
-      planner.buffer_segment(end, scaled_fr_mm_s, extruder);
+      #ifdef LEVELED_MERGE_TOLERANCE
+        const float zc = isnan(z0) ? 0.0f : z0;
+        end.z += zc;
+        if (merge.add(end, zc, buffer)) merge.flush(buffer);
+      #else
+        if (!isnan(z0)) end.z += z0;
+        planner.buffer_segment(end, scaled_fr_mm_s, extruder);
+      #endif
       current_position = destination;
       return;
     }
 
+    #ifdef LEVELED_MERGE_TOLERANCE
+      // The last move left off at the correction for this point
+      float start_z = get_z_correction(start) * planner.fade_scaling_factor_for_z(end.z);
+      merge.start(start, isnan(start_z) ? 0.0f : start_z);
+    #endif
+
     /**
      * Past this point the move is known to cross one or more mesh lines. Check for the most common
      * case - crossing only one X or Y line - after details are worked out to reduce computation.
@@ -174,7 +197,7 @@
           }
 
           dest.z += z0;
-          planner.buffer_segment(dest, scaled_fr_mm_s, extruder);
+          BUFFER_SEGMENT(dest, z0);
 
         } //else printf("FIRST MOVE PRUNED  ");
       }
@@ -183,6 +206,7 @@
       if (xy_pos_t(current_position) != xy_pos_t(end))
         goto FINAL_MOVE;
 
+      FLUSH_SEGMENTS();
       current_position = destination;
       return;
     }
@@ -223,7 +247,7 @@
           }
 
           dest.z += z0;
-          if (!planner.buffer_segment(dest, scaled_fr_mm_s, extruder)) break;
+          if (!BUFFER_SEGMENT(dest, z0)) break;
 
         } //else printf("FIRST MOVE PRUNED  ");
       }
@@ -231,6 +255,7 @@
       if (xy_pos_t(current_position) != xy_pos_t(end))
         goto FINAL_MOVE;
 
+      FLUSH_SEGMENTS();
       current_position = destination;
       return;
     }
@@ -276,7 +301,7 @@
         }
 
         dest.z += z0;
-        if (!planner.buffer_segment(dest, scaled_fr_mm_s, extruder)) break;
+        if (!BUFFER_SEGMENT(dest, z0)) break;
 
         icell.y += iadd.y;
         cnt.y--;
@@ -303,7 +328,7 @@
         }
 
         dest.z += z0;
-        if (!planner.buffer_segment(dest, scaled_fr_mm_s, extruder)) break;
+        if (!BUFFER_SEGMENT(dest, z0)) break;
 
         icell.x += iadd.x;
         cnt.x--;
@@ -315,6 +340,7 @@
     if (xy_pos_t(current_position) != xy_pos_t(end))
       goto FINAL_MOVE;
 
+    FLUSH_SEGMENTS();
     current_position = destination;
   }
 
@@ -0,0 +1,108 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/buffer_arena.cpp - Planner blocks and command slots sharing one static buffer
+ *
+ * The arena holds BLOCK_BUFFER_SIZE planner blocks followed by BUFSIZE
+ * command lines. M577 moves the split at runtime, trading planner
+ * look-ahead for command queue slots and vice-versa.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(BUFFER_ARENA)
+
+#include "buffer_arena.h"
+#include "../module/planner.h"
+#include "../gcode/queue.h"
+
+BufferArena buffer_arena;
+
+typedef GCodeQueue::CommandLine CommandLine;
+
+#define ARENA_SIZE ((BLOCK_BUFFER_SIZE) * sizeof(block_t) + (BUFSIZE) * sizeof(CommandLine))
+#define MIN_ARENA_ITEMS 2
+
+static union {
+  block_t blocks[1];
+  uint8_t bytes[ARENA_SIZE];
+} arena;
+
+// Command lines that fit after the given number of planner blocks
+uint8_t BufferArena::commands_for(const uint8_t blocks) {
+  const size_t block_bytes = blocks * sizeof(block_t);
+  return block_bytes < ARENA_SIZE ? _MIN((ARENA_SIZE - block_bytes) / sizeof(CommandLine), size_t(UINT8_MAX)) : 0;
+}
+
+void BufferArena::init() {
+  planner.block_buffer = arena.blocks;
+  planner.block_buffer_mask = (BLOCK_BUFFER_SIZE) - 1;
+  queue.ring_buffer.commands = (CommandLine*)&arena.bytes[(BLOCK_BUFFER_SIZE) * sizeof(block_t)];
+  queue.ring_buffer.size = commands_for(BLOCK_BUFFER_SIZE);
+}
+
+static void swap_commands(CommandLine * const cmds, uint8_t a, uint8_t b) {
+  for (; a < b; a++, b--) {
+    const CommandLine tmp = cmds[a];
+    cmds[a] = cmds[b];
+    cmds[b] = tmp;
+  }
+}
+
+/**
+ * Give the planner the given number of blocks and the command queue the rest.
+ * The planner must be empty. Queued commands, including the one being run,
+ * are kept in order at the start of the new command area.
+ */
+bool BufferArena::resize(const uint8_t blocks) {
+  GCodeQueue::RingBuffer &ring = queue.ring_buffer;
+  const uint8_t commands = commands_for(blocks);
+  if (blocks < MIN_ARENA_ITEMS || blocks > BUFFER_ARENA_MAX_BLOCKS || !IS_POWER_OF_2(blocks) || commands < _MAX(MIN_ARENA_ITEMS, ring.length))
+    return false;
+
+  // Rotate the ring in place so the next command to run is first
+  if (ring.length && ring.index_r) {
+    const uint8_t last = ring.size - 1;
+    swap_commands(ring.commands, 0, ring.index_r - 1);
+    swap_commands(ring.commands, ring.index_r, last);
+    swap_commands(ring.commands, 0, last);
+  }
+
+  // Move the queued commands to the new start of the command area
+  CommandLine * const cmds = (CommandLine*)&arena.bytes[blocks * sizeof(block_t)];
+  memmove(cmds, ring.commands, ring.length * sizeof(CommandLine));
+
+  planner.clear_block_buffer();
+  planner.block_buffer_mask = blocks - 1;
+  ring.commands = cmds;
+  ring.size = commands;
+  ring.index_r = 0;
+  ring.index_w = ring.length < commands ? ring.length : 0;
+  return true;
+}
+
+void BufferArena::report() {
+  SERIAL_ECHOLNPGM("Planner blocks:", planner.block_buffer_mask + 1, " Command slots:", queue.ring_buffer.size, " Arena bytes:", uint32_t(ARENA_SIZE));
+}
+
+#endif // BUFFER_ARENA
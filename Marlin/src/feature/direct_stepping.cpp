@@ -28,6 +28,11 @@
 
 #include "../MarlinCore.h"
 
+#if ENABLED(DIRECT_STEPPING_COMPRESSION)
+  #include "../libs/heatshrink/heatshrink_decoder.h"
+  static heatshrink_decoder hsd;
+#endif
+
 #define CHECK_PAGE(I, R) do{                                \
   if (I >= sizeof(page_states) / sizeof(page_states[0])) {  \
     fatal_error = true;                                     \
@@ -72,6 +77,31 @@ namespace DirectStepping {
   template<typename Cfg>
   typename Cfg::write_byte_idx_t SerialPageManager<Cfg>::write_page_size;
 
+  #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+
+    template<typename Cfg>
+    uint8_t SerialPageManager<Cfg>::packed[DIRECT_STEPPING_DECODE_BUFFERS][Cfg::PAGE_SIZE];
+
+    template<typename Cfg>
+    typename Cfg::write_byte_idx_t SerialPageManager<Cfg>::packed_size[DIRECT_STEPPING_DECODE_BUFFERS];
+
+    template<typename Cfg>
+    typename Cfg::page_idx_t SerialPageManager<Cfg>::packed_page[DIRECT_STEPPING_DECODE_BUFFERS];
+
+    template<typename Cfg>
+    volatile uint8_t SerialPageManager<Cfg>::packed_head;
+
+    template<typename Cfg>
+    volatile uint8_t SerialPageManager<Cfg>::packed_tail;
+
+    template<typename Cfg>
+    bool SerialPageManager<Cfg>::write_packed;
+
+    template<typename Cfg>
+    uint8_t *SerialPageManager<Cfg>::write_buffer;
+
+  #endif
+
   template <typename Cfg>
   void SerialPageManager<Cfg>::init() {
     for (int i = 0 ; i < Cfg::NUM_PAGES ; i++)
@@ -82,6 +112,11 @@ namespace DirectStepping {
 
     page_states_dirty = false;
 
+    #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+      packed_head = packed_tail = 0;
+      SERIAL_ECHOLNPGM("pages_compression:heatshrink,", HEATSHRINK_STATIC_WINDOW_BITS, ",", HEATSHRINK_STATIC_LOOKAHEAD_BITS, ",", DIRECT_STEPPING_DECODE_BUFFERS);
+    #endif
+
     SERIAL_ECHOLNPGM("pages_ready");
   }
 
@@ -100,8 +135,15 @@ namespace DirectStepping {
       case State::NEWLINE:
         switch (c) {
           case Cfg::CONTROL_CHAR:
+            TERN_(DIRECT_STEPPING_COMPRESSION, write_packed = false);
             state = State::ADDRESS;
             return true;
+          #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+            case Cfg::PACKED_CHAR:
+              write_packed = true;
+              state = State::ADDRESS;
+              return true;
+          #endif
           case '\n':
           case '\r':
             state = State::NEWLINE;
@@ -126,6 +168,18 @@ namespace DirectStepping {
 
         set_page_state(write_page_idx, PageState::WRITING);
 
+        #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+          if (write_packed) {
+            // Always sized. With every decode buffer waiting the bytes are dropped and the page fails.
+            write_buffer = uint8_t(packed_head - packed_tail) < (DIRECT_STEPPING_DECODE_BUFFERS)
+              ? packed[packed_head & ((DIRECT_STEPPING_DECODE_BUFFERS) - 1)]
+              : nullptr;
+            state = State::SIZE;
+            return true;
+          }
+          write_buffer = pages[write_page_idx];
+        #endif
+
         state = Cfg::DIRECTIONAL ? State::COLLECT : State::SIZE;
 
         return true;
@@ -134,19 +188,26 @@ namespace DirectStepping {
         write_page_size = c;
         state = State::COLLECT;
         return true;
-      case State::COLLECT:
-        pages[write_page_idx][write_byte_idx++] = c;
+      case State::COLLECT: {
+        #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+          if (write_buffer) write_buffer[write_byte_idx] = c;
+          write_byte_idx++;
+          const bool full_page = Cfg::DIRECTIONAL && !write_packed;
+        #else
+          pages[write_page_idx][write_byte_idx++] = c;
+          constexpr bool full_page = Cfg::DIRECTIONAL;
+        #endif
         checksum ^= c;
 
         // check if still collecting
         if (Cfg::PAGE_SIZE == 256) {
           // special case for 8-bit, check if rolled back to 0
-          if (Cfg::DIRECTIONAL || !write_page_size) { // full 256 bytes
+          if (full_page || !write_page_size) { // full 256 bytes
             if (write_byte_idx) return true;
           } else {
             if (write_byte_idx < write_page_size) return true;
           }
-        } else if (Cfg::DIRECTIONAL) {
+        } else if (full_page) {
           if (write_byte_idx != Cfg::PAGE_SIZE) return true;
         } else {
           if (write_byte_idx < write_page_size) return true;
@@ -154,8 +215,24 @@ namespace DirectStepping {
 
         state = State::CHECKSUM;
         return true;
+      }
       case State::CHECKSUM: {
-        const PageState page_state = (checksum == c) ? PageState::OK : PageState::FAIL;
+        // A page G6 gave up on stays failed
+        PageState page_state = (checksum == c && page_states[write_page_idx] == PageState::WRITING) ? PageState::OK : PageState::FAIL;
+        #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+          if (write_packed && page_state == PageState::OK) {
+            if (write_buffer) {
+              // The page stays WRITING until decode_pages() has filled it
+              const uint8_t i = packed_head & ((DIRECT_STEPPING_DECODE_BUFFERS) - 1);
+              packed_page[i] = write_page_idx;
+              packed_size[i] = write_byte_idx;
+              packed_head++;
+              state = State::MONITOR;
+              return true;
+            }
+            page_state = PageState::FAIL;
+          }
+        #endif
         set_page_state(write_page_idx, page_state);
         state = State::MONITOR;
         return true;
@@ -173,6 +250,8 @@ namespace DirectStepping {
 
   template <typename Cfg>
   void SerialPageManager<Cfg>::write_responses() {
+    TERN_(DIRECT_STEPPING_COMPRESSION, decode_pages());
+
     if (fatal_error) {
       kill(GET_TEXT_F(MSG_BAD_PAGE));
       return;
@@ -200,6 +279,50 @@ namespace DirectStepping {
     SERIAL_EOL();
   }
 
+  #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+
+    // Decode the compressed pages the serial ISR has collected
+    template <typename Cfg>
+    void SerialPageManager<Cfg>::decode_pages() {
+      while (packed_tail != packed_head) {
+        const uint8_t i = packed_tail & ((DIRECT_STEPPING_DECODE_BUFFERS) - 1);
+        if (page_states[packed_page[i]] == PageState::WRITING)
+          set_page_state(packed_page[i], decode_page(i) ? PageState::OK : PageState::FAIL);
+        packed_tail++;
+      }
+    }
+
+    /**
+     * Decode one compressed page into its page. Fail if the data is bad or
+     * decodes to more than a page (or less than a page, in a directional format).
+     */
+    template <typename Cfg>
+    bool SerialPageManager<Cfg>::decode_page(const uint8_t i) {
+      uint8_t * const src = packed[i], * const dst = pages[packed_page[i]];
+      const size_t size = packed_size[i] ? packed_size[i] : 256; // 0 is a full 8-bit size
+      size_t in = 0, out = 0, count;
+
+      heatshrink_decoder_reset(&hsd);
+      for (;;) {
+        if (in < size) {
+          heatshrink_decoder_sink(&hsd, &src[in], size - in, &count);
+          in += count;
+        }
+        // With the page full, poll one byte more to catch overlong data
+        uint8_t spill;
+        const bool full = (out == Cfg::PAGE_SIZE);
+        const HSD_poll_res res = heatshrink_decoder_poll(&hsd, full ? &spill : &dst[out], full ? 1 : Cfg::PAGE_SIZE - out, &count);
+        if (res < 0 || (full && count)) return false;
+        out += count;
+        if (res == HSDR_POLL_EMPTY && in == size) break;
+      }
+
+      if (heatshrink_decoder_finish(&hsd) != HSDR_FINISH_DONE) return false;
+      return out && (out == Cfg::PAGE_SIZE || !Cfg::DIRECTIONAL);
+    }
+
+  #endif
+
   template <typename Cfg>
   FORCE_INLINE void SerialPageManager<Cfg>::set_page_state(const page_idx_t page_idx, const PageState page_state) {
     CHECK_PAGE(page_idx,);
@@ -220,6 +343,11 @@ namespace DirectStepping {
     set_page_state(page_idx, PageState::FREE);
   }
 
+  template <typename Cfg>
+  void SerialPageManager<Cfg>::fail_page(const page_idx_t page_idx) {
+    set_page_state(page_idx, PageState::FAIL);
+  }
+
 };
 
 DirectStepping::PageManager page_manager;
@@ -56,11 +56,18 @@ namespace DirectStepping {
     static bool maybe_store_rxd_char(uint8_t c);
     static void write_responses();
 
+    static PageState page_state(const page_idx_t page_idx) {
+      return page_idx < Cfg::NUM_PAGES ? page_states[page_idx] : PageState::FAIL;
+    }
+
     // common methods for page managers
     static void init();
     static uint8_t *get_page(const page_idx_t page_idx);
     static void free_page(const page_idx_t page_idx);
 
+    // Give up on a page that stopped arriving. It stays failed until the host resends it.
+    static void fail_page(const page_idx_t page_idx);
+
   protected:
 
     typedef typename Cfg::write_byte_idx_t write_byte_idx_t;
@@ -78,6 +85,19 @@ namespace DirectStepping {
     static write_byte_idx_t write_page_size;
 
     static void set_page_state(const page_idx_t page_idx, const PageState page_state);
+
+    #if ENABLED(DIRECT_STEPPING_COMPRESSION)
+      // Compressed pages are collected here by the serial ISR and decoded into the page by the main loop
+      static uint8_t packed[DIRECT_STEPPING_DECODE_BUFFERS][Cfg::PAGE_SIZE];
+      static write_byte_idx_t packed_size[DIRECT_STEPPING_DECODE_BUFFERS];
+      static page_idx_t packed_page[DIRECT_STEPPING_DECODE_BUFFERS];
+      static volatile uint8_t packed_head, packed_tail; // Written by the serial ISR / the main loop
+      static bool write_packed;
+      static uint8_t *write_buffer;                     // nullptr when no decode buffer is free
+
+      static void decode_pages();
+      static bool decode_page(const uint8_t i);
+    #endif
   };
 
   template<bool b, typename T, typename F> struct TypeSelector { typedef T type;} ;
@@ -86,6 +106,7 @@ namespace DirectStepping {
   template <int num_pages, int num_axes, int bits_segment, bool dir, int segments>
   struct config_t {
     static constexpr char CONTROL_CHAR  = '!';
+    static constexpr char PACKED_CHAR   = '#';
 
     static constexpr int NUM_PAGES      = num_pages;
     static constexpr int NUM_AXES       = num_axes;
@@ -0,0 +1,119 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/isr_profiler.cpp - Time spent in the Stepper and Temperature ISRs, by phase
+ *
+ * Durations are taken with the stepper timer, so the resolution is
+ * (F_CPU) / (STEPPER_TIMER_RATE) cycles. Each profiled phase adds some
+ * cycles of its own, mostly to the Stepper ISR total.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(ISR_PROFILER)
+
+#include "isr_profiler.h"
+
+IsrProfiler isr_profiler;
+
+isr_stats_t IsrProfiler::stats[ISR_PHASES];
+uint32_t IsrProfiler::epoch; // = 0
+hal_timer_t IsrProfiler::period; // = 0
+millis_t IsrProfiler::window_start_ms; // = 0
+
+#define ISR_PROFILE_CYCLES_PER_TICK ((F_CPU) / (STEPPER_TIMER_RATE))
+
+void IsrProfiler::add(const IsrPhase phase, const uint32_t ticks) {
+  isr_stats_t &s = stats[phase];
+
+  // Start a new window rather than overflow the total
+  if (s.total + ticks < s.total) reset();
+
+  if (!s.count++ || ticks < s.min) s.min = ticks;
+  NOLESS(s.max, ticks);
+  s.total += ticks;
+
+  uint8_t bucket = 0;
+  for (uint32_t t = ticks; t > 1 && bucket < ISR_PROFILE_BUCKETS - 1; t >>= 1) bucket++;
+  s.histogram[bucket]++;
+}
+
+void IsrProfiler::add_interrupt(const IsrPhase phase, const uint32_t ticks) {
+  add(phase, ticks);
+  CRITICAL_SECTION_START();
+  epoch -= ticks;
+  CRITICAL_SECTION_END();
+}
+
+void IsrProfiler::reset() {
+  CRITICAL_SECTION_START();
+  ZERO(stats);
+  CRITICAL_SECTION_END();
+  window_start_ms = millis();
+}
+
+void IsrProfiler::report() {
+  static PGMSTR(str_stepper, "Stepper");
+  static PGMSTR(str_pulse, " Pulse");
+  static PGMSTR(str_block, " Block");
+  static PGMSTR(str_s_curve, "  S-curve");
+  static PGMSTR(str_advance, " Advance");
+  static PGMSTR(str_shaping, " Shaping");
+  static PGMSTR(str_babystep, " Babystep");
+  static PGMSTR(str_temperature, "Temperature");
+  static PGM_P const phase_name[ISR_PHASES] PROGMEM = {
+    str_stepper, str_pulse, str_block, str_s_curve, str_advance, str_shaping, str_babystep, str_temperature
+  };
+
+  const millis_t ms = millis() - window_start_ms;
+  SERIAL_ECHOLNPGM("ISR profile in cycles over ", ms, "ms");
+
+  LOOP_L_N(p, ISR_PHASES) {
+    // Copy the stats so the ISRs don't change them mid-report
+    CRITICAL_SECTION_START();
+    const isr_stats_t s = stats[p];
+    CRITICAL_SECTION_END();
+    if (!s.count) continue;
+
+    SERIAL_ECHOPGM_P((char*)pgm_read_ptr(&phase_name[p]));
+    SERIAL_ECHOPGM(
+      " n:", s.count,
+      " min:", s.min * ISR_PROFILE_CYCLES_PER_TICK,
+      " avg:", s.total / s.count * ISR_PROFILE_CYCLES_PER_TICK,
+      " max:", s.max * ISR_PROFILE_CYCLES_PER_TICK
+    );
+    if (ms) {
+      SERIAL_ECHOPAIR_F(" load:", 100.0f * s.total / ((STEPPER_TIMER_RATE) / 1000.0f) / ms);
+      SERIAL_CHAR('%');
+    }
+    SERIAL_EOL();
+
+    // Counts by duration, from the bucket's lowest cycle count
+    SERIAL_ECHOPGM(" ");
+    LOOP_L_N(b, ISR_PROFILE_BUCKETS) if (s.histogram[b])
+      SERIAL_ECHOPGM(" ", _BV32(b) * ISR_PROFILE_CYCLES_PER_TICK, "+:", s.histogram[b]);
+    SERIAL_EOL();
+  }
+}
+
+#endif // ISR_PROFILER
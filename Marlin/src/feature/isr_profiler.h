@@ -0,0 +1,106 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/isr_profiler.h - Time spent in the Stepper and Temperature ISRs, by phase
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(ISR_PROFILER)
+
+enum IsrPhase : uint8_t {
+  ISR_STEPPER,      // Stepper::isr(), including its phases
+  ISR_PULSE,        // Stepper::pulse_phase_isr()
+  ISR_BLOCK,        // Stepper::block_phase_isr()
+  ISR_S_CURVE,      // S-curve speed evaluation in Stepper::block_phase_isr()
+  ISR_ADVANCE,      // Stepper::advance_isr()
+  ISR_SHAPING,      // Stepper::shaping_isr()
+  ISR_BABYSTEP,     // Stepper::babystepping_isr()
+  ISR_TEMPERATURE,  // Temperature::isr()
+  ISR_PHASES
+};
+
+// Histogram bucket N counts durations of 2^N to 2^(N+1)-1 stepper timer ticks
+#define ISR_PROFILE_BUCKETS 16
+
+typedef struct {
+  uint32_t count,   // Calls
+           total,   // Stepper timer ticks spent
+           min, max;
+  uint32_t histogram[ISR_PROFILE_BUCKETS];
+} isr_stats_t;
+
+class IsrProfiler {
+  public:
+    static isr_stats_t stats[ISR_PHASES];
+
+    /**
+     * The stepper timer restarts from 0 at every Stepper ISR. Extending it with the
+     * periods that ran out gives a 32-bit clock for all the ISRs. Time spent in an ISR
+     * is also taken out of the clock, so any ISR it interrupted doesn't count it.
+     */
+    static uint32_t epoch;        // Clock ticks up to the start of the current stepper period
+    static hal_timer_t period;    // The stepper period that's running
+
+    // Call at the start of the Stepper ISR, with interrupts disabled
+    FORCE_INLINE static void stepper_timer_restarted() { epoch += period; }
+
+    // Call at the end of the Stepper ISR, with the compare value just set
+    FORCE_INLINE static void stepper_timer_period(const hal_timer_t ticks) { period = ticks; }
+
+    // Stepper timer ticks, less the time spent in interrupting ISRs
+    FORCE_INLINE static uint32_t now() {
+      CRITICAL_SECTION_START();
+      const uint32_t t = epoch + HAL_timer_get_count(MF_TIMER_STEP);
+      CRITICAL_SECTION_END();
+      return t;
+    }
+
+    // Add a duration to the stats for the phase
+    static void add(const IsrPhase phase, const uint32_t ticks);
+
+    // Add an interrupt's duration and hide it from any code it interrupted
+    static void add_interrupt(const IsrPhase phase, const uint32_t ticks);
+
+    static void reset();
+    static void report();
+
+  private:
+    static millis_t window_start_ms;
+};
+
+extern IsrProfiler isr_profiler;
+
+// Profile a part of an ISR
+#define ISR_PROFILE(P, V...) do{ const uint32_t _isr_t0 = isr_profiler.now(); V; isr_profiler.add(P, isr_profiler.now() - _isr_t0); }while(0)
+
+// Profile a whole ISR
+#define ISR_PROFILE_INTERRUPT(P, V...) do{ const uint32_t _isr_t0 = isr_profiler.now(); V; isr_profiler.add_interrupt(P, isr_profiler.now() - _isr_t0); }while(0)
+
+#else
+
+#define ISR_PROFILE(P, V...) V
+#define ISR_PROFILE_INTERRUPT(P, V...) V
+
+#endif
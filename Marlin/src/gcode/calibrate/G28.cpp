@@ -240,6 +240,19 @@ void GcodeSuite::G28() {
   TERN_(HAS_DWIN_E3V2_BASIC, DWIN_StartHoming());
   TERN_(EXTENSIBLE_UI, ExtUI::onHomingStart());
 
+  #if HAS_SHAPING
+    // Shaped steps trail the commanded position, so home with shaping off
+    constexpr shaping_settings_t unshaped = { ShapingType::ZV, 0, 0 };
+    #if ENABLED(INPUT_SHAPING_X)
+      const shaping_settings_t saved_shaping_x = stepper.shaper_x.settings;
+      stepper.set_shaping(stepper.shaper_x, unshaped);
+    #endif
+    #if ENABLED(INPUT_SHAPING_Y)
+      const shaping_settings_t saved_shaping_y = stepper.shaper_y.settings;
+      stepper.set_shaping(stepper.shaper_y, unshaped);
+    #endif
+  #endif
+
   planner.synchronize();          // Wait for planner moves to finish!
 
   SET_SOFT_ENDSTOP_LOOSE(false);  // Reset a leftover 'loose' motion state
@@ -501,6 +514,13 @@ void GcodeSuite::G28() {
 
   restore_feedrate_and_scaling();
 
+  #if ENABLED(INPUT_SHAPING_X)
+    stepper.set_shaping(stepper.shaper_x, saved_shaping_x);
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    stepper.set_shaping(stepper.shaper_y, saved_shaping_y);
+  #endif
+
   // Restore the active tool after homing
   #if HAS_MULTI_HOTEND && (DISABLED(DELTA) || ENABLED(DELTA_HOME_TO_SAFE_ZONE))
     tool_change(old_tool_index, TERN(PARKING_EXTRUDER, !pe_final_change_must_unpark, DISABLED(DUAL_X_CARRIAGE)));   // Do move if one of these
@@ -0,0 +1,52 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(BUFFER_ARENA)
+
+#include "../gcode.h"
+#include "../../feature/buffer_arena.h"
+#include "../../module/planner.h"
+
+/**
+ * M577 - Split the buffer arena between planner blocks and command slots
+ *
+ *   B<blocks> - Number of planner blocks. A power of 2 from 2 to 64.
+ *               The command queue gets the rest of the arena.
+ *
+ * Waits for the planner to empty before changing the split.
+ * With no parameters, report the current split.
+ */
+void GcodeSuite::M577() {
+  if (parser.seenval('B')) {
+    const uint16_t blocks = parser.value_ushort();
+    planner.synchronize();
+    if (blocks > 255 || !buffer_arena.resize(blocks)) {
+      SERIAL_ERROR_MSG("?(B)locks must be a power of 2 from 2 to 64, leaving room for the queued commands.");
+      return;
+    }
+  }
+  buffer_arena.report();
+}
+
+#endif // BUFFER_ARENA
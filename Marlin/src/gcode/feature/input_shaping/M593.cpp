@@ -0,0 +1,98 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if HAS_SHAPING
+
+#include "../../gcode.h"
+#include "../../../module/stepper.h"
+
+static void say_shaping(const char axis, const shaping_settings_t &s) {
+  SERIAL_ECHOLNPGM("  M593 ", AS_CHAR(axis), " F", s.frequency, " D", s.zeta, " T", uint8_t(s.type));
+}
+
+/**
+ * M593: Get or Set Input Shaping parameters
+ *  X           Set the X axis. (Default: all shaped axes)
+ *  Y           Set the Y axis.
+ *  F<hz>       Resonant frequency. 0 to turn off shaping.
+ *  D<zeta>     Damping ratio (0.0 - 1.0)
+ *  T<type>     Shaper type: 0 = ZV, 1 = ZVD, 2 = MZV
+ */
+void GcodeSuite::M593() {
+  if (!parser.seen("FDT")) return M593_report(false);
+
+  const bool seen_x = parser.seen_test('X'), seen_y = parser.seen_test('Y'),
+             for_all = !seen_x && !seen_y;
+
+  auto apply = [](AxisShaper &shaper) {
+    shaping_settings_t s = shaper.settings;
+
+    if (parser.seenval('F')) {
+      const float f = parser.value_float();
+      if (f == 0 || WITHIN(f, SHAPING_MIN_FREQ, 500))
+        s.frequency = f;
+      else
+        SERIAL_ECHOLNPGM("?F value out of range (0 or " STRINGIFY(SHAPING_MIN_FREQ) "-500).");
+    }
+
+    if (parser.seenval('D')) {
+      const float d = parser.value_float();
+      if (WITHIN(d, 0, 1))
+        s.zeta = d;
+      else
+        SERIAL_ECHOLNPGM("?D value out of range (0.0-1.0).");
+    }
+
+    if (parser.seenval('T')) {
+      const uint8_t t = parser.value_byte();
+      if (t <= uint8_t(ShapingType::MZV))
+        s.type = ShapingType(t);
+      else
+        SERIAL_ECHOLNPGM("?T value out of range (0-2).");
+    }
+
+    stepper.set_shaping(shaper, s);
+  };
+
+  #if ENABLED(INPUT_SHAPING_X)
+    if (for_all || seen_x) apply(stepper.shaper_x);
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    if (for_all || seen_y) apply(stepper.shaper_y);
+  #endif
+}
+
+void GcodeSuite::M593_report(const bool forReplay/*=true*/) {
+  report_heading(forReplay, F(STR_INPUT_SHAPING));
+  #if ENABLED(INPUT_SHAPING_X)
+    report_echo_start(forReplay);
+    say_shaping('X', stepper.shaper_x.settings);
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    report_echo_start(forReplay);
+    say_shaping('Y', stepper.shaper_y.settings);
+  #endif
+}
+
+#endif // HAS_SHAPING
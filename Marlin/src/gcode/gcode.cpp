@@ -891,6 +891,18 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 575: M575(); break;                                  // M575: Set serial baudrate
       #endif
 
+      #if ENABLED(BUFFER_ARENA)
+        case 577: M577(); break;                                  // M577: Split the buffer arena
+      #endif
+
+      #if ENABLED(ISR_PROFILER)
+        case 578: M578(); break;                                  // M578: Report the ISR profile
+      #endif
+
+      #if HAS_SHAPING
+        case 593: M593(); break;                                  // M593: Set Input Shaping parameters
+      #endif
+
       #if ENABLED(ADVANCED_PAUSE_FEATURE)
         case 600: M600(); break;                                  // M600: Pause for Filament Change
         case 603: M603(); break;                                  // M603: Configure Filament Change
@@ -255,6 +255,9 @@
  * M554 - Get or set IP gateway. (Requires enabled Ethernet port)
  * M569 - Enable stealthChop on an axis. (Requires at least one _DRIVER_TYPE to be TMC2130/2160/2208/2209/5130/5160)
  * M575 - Change the serial baud rate. (Requires BAUD_RATE_GCODE)
+ * M577 - Split the buffer arena between planner and command queue: "M577 B<blocks>". (Requires BUFFER_ARENA)
+ * M578 - Report the ISR profile, or reset it with "M578 R". (Requires ISR_PROFILER)
+ * M593 - Set Input Shaping parameters: "M593 [X] [Y] F<hz> D<zeta> T<type>". (Requires INPUT_SHAPING_X or INPUT_SHAPING_Y)
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
  * M605 - Set Dual X-Carriage movement mode: "M605 S<mode> [X<x_offset>] [R<temp_offset>]". (Requires DUAL_X_CARRIAGE)
@@ -1055,6 +1058,19 @@ private:
     static void M575();
   #endif
 
+  #if ENABLED(BUFFER_ARENA)
+    static void M577();
+  #endif
+
+  #if ENABLED(ISR_PROFILER)
+    static void M578();
+  #endif
+
+  #if HAS_SHAPING
+    static void M593();
+    static void M593_report(const bool forReplay=true);
+  #endif
+
   #if ENABLED(ADVANCED_PAUSE_FEATURE)
     static void M600();
     static void M603();
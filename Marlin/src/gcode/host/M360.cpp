@@ -25,6 +25,7 @@
 #if ENABLED(REPETIER_GCODE_M360)
 
 #include "../gcode.h"
+#include "../queue.h"
 
 #include "../../module/motion.h"
 #include "../../module/planner.h"
@@ -68,7 +69,7 @@ void GcodeSuite::M360() {
   //
   config_line(F("Baudrate"),                    BAUDRATE);
   config_line(F("InputBuffer"),                 MAX_CMD_SIZE);
-  config_line(F("PrintlineCache"),              BUFSIZE);
+  config_line(F("PrintlineCache"),              queue.ring_buffer.capacity());
   config_line(F("MixingExtruder"),              ENABLED(MIXING_EXTRUDER));
   config_line(F("SDCard"),                      ENABLED(SDSUPPORT));
   config_line(F("Fan"),                         ENABLED(HAS_FAN));
@@ -51,6 +51,39 @@
 #define ARC_LIJK_CODE(L,I,J,K)    CODE_N(SUB2(LINEAR_AXES),L,I,J,K)
 #define ARC_LIJKE_CODE(L,I,J,K,E) ARC_LIJK_CODE(L,I,J,K); CODE_ITEM_E(E)
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * An arc can go to the planner as blocks of chords if it's in the XY plane and
+   * neither leveling, skew, nor the soft endstops would bend its path.
+   */
+  static bool can_buffer_arc(const xy_pos_t &center, const float radius, const xyze_pos_t &cart) {
+    if (TERN0(CNC_WORKSPACE_PLANES, gcode.workspace_plane != GcodeSuite::PLANE_XY)) return false;
+    if (TERN0(HAS_LEVELING, planner.leveling_active)) return false;
+    if (TERN0(SKEW_CORRECTION, planner.skew_factor.xy || planner.skew_factor.xz || planner.skew_factor.yz)) return false;
+
+    // Check the box around the whole circle
+    xyz_pos_t lo = current_position, hi = cart;
+    lo.x = center.x - radius; lo.y = center.y - radius;
+    hi.x = center.x + radius; hi.y = center.y + radius;
+    const xyz_pos_t lo_in = lo, hi_in = hi;
+    apply_motion_limits(lo);
+    apply_motion_limits(hi);
+    return lo == lo_in && hi == hi_in;
+  }
+
+  /**
+   * Queue the chords as one arc block, or as lines if the planner can't take them
+   * as an arc. chord_ends[0] is the start of the first chord.
+   */
+  static bool buffer_arc_chords(const xyze_pos_t chord_ends[], const uint8_t chords, const_feedRate_t fr_mm_s) {
+    if (planner.buffer_arc(chord_ends, chords, fr_mm_s)) return true;
+    LOOP_S_LE_N(i, 1, chords) if (!planner.buffer_line(chord_ends[i], fr_mm_s, active_extruder)) return false;
+    return true;
+  }
+
+#endif
+
 /**
  * Plan an arc in 2 dimensions, with linear motion in the other axes.
  * The arc is traced with many small linear segments according to the configuration.
@@ -179,28 +212,51 @@ void plan_arc(
   // Feedrate for the move, scaled by the feedrate multiplier
   const feedRate_t scaled_fr_mm_s = MMS_SCALED(feedrate_mm_s);
 
-  // Get the nominal segment length based on settings
-  const float nominal_segment_mm = (
-    #if ARC_SEGMENTS_PER_SEC  // Length based on segments per second and feedrate
-      constrain(scaled_fr_mm_s * RECIPROCAL(ARC_SEGMENTS_PER_SEC), MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM)
-    #else
-      MAX_ARC_SEGMENT_MM      // Length using the maximum segment size
+  #ifdef ARC_CHORD_TOLERANCE
+
+    /**
+     * Size the segments so no chord strays more than ARC_CHORD_TOLERANCE from the arc.
+     * The sagitta of a chord over angle θ is r(1 - cos(θ/2)) <= rθ²/8, so segments of
+     * rθ = sqrt(8 * tolerance * r) are safe without any trig. Large arcs get long
+     * segments and small arcs short ones, all the same length to end exactly on target.
+     */
+    const float nominal_segment_mm = constrain(SQRT(8 * (ARC_CHORD_TOLERANCE) * 0.001f * radius), MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM);
+
+    uint16_t segments = _MAX(CEIL(flat_mm / nominal_segment_mm), min_segments);
+    NOMORE(segments, _MAX(1, FLOOR(flat_mm / (MIN_ARC_SEGMENT_MM))));
+
+    #if ENABLED(SCARA_FEEDRATE_SCALING)
+      const float segment_mm = flat_mm / segments;
     #endif
-  );
+    constexpr bool tooshort = false;
+    constexpr float proportion = 1.0f;
 
-  // Number of whole segments based on the nominal segment length
-  const float nominal_segments = _MAX(FLOOR(flat_mm / nominal_segment_mm), min_segments);
+  #else
 
-  // A new segment length based on the required minimum
-  const float segment_mm = constrain(flat_mm / nominal_segments, MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM);
+    // Get the nominal segment length based on settings
+    const float nominal_segment_mm = (
+      #if ARC_SEGMENTS_PER_SEC  // Length based on segments per second and feedrate
+        constrain(scaled_fr_mm_s * RECIPROCAL(ARC_SEGMENTS_PER_SEC), MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM)
+      #else
+        MAX_ARC_SEGMENT_MM      // Length using the maximum segment size
+      #endif
+    );
+
+    // Number of whole segments based on the nominal segment length
+    const float nominal_segments = _MAX(FLOOR(flat_mm / nominal_segment_mm), min_segments);
+
+    // A new segment length based on the required minimum
+    const float segment_mm = constrain(flat_mm / nominal_segments, MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM);
 
-  // The number of whole segments in the arc, ignoring the remainder
-  uint16_t segments = FLOOR(flat_mm / segment_mm);
+    // The number of whole segments in the arc, ignoring the remainder
+    uint16_t segments = FLOOR(flat_mm / segment_mm);
 
-  // Are the segments now too few to reach the destination?
-  const float segmented_length = segment_mm * segments;
-  const bool tooshort = segmented_length < flat_mm - 0.0001f;
-  const float proportion = tooshort ? segmented_length / flat_mm : 1.0f;
+    // Are the segments now too few to reach the destination?
+    const float segmented_length = segment_mm * segments;
+    const bool tooshort = segmented_length < flat_mm - 0.0001f;
+    const float proportion = tooshort ? segmented_length / flat_mm : 1.0f;
+
+  #endif
 
   /**
    * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
@@ -230,10 +286,15 @@ void plan_arc(
    */
   // Vector rotation matrix values
   xyze_pos_t raw;
-  const float theta_per_segment = proportion * angular_travel / segments,
-              sq_theta_per_segment = sq(theta_per_segment),
-              sin_T = theta_per_segment - sq_theta_per_segment * theta_per_segment / 6,
-              cos_T = 1 - 0.5f * sq_theta_per_segment; // Small angle approximation
+  const float theta_per_segment = proportion * angular_travel / segments;
+  #ifdef ARC_CHORD_TOLERANCE
+    // Chordal segments may be too long for the small angle approximation
+    const float sin_T = sin(theta_per_segment), cos_T = cos(theta_per_segment);
+  #else
+    const float sq_theta_per_segment = sq(theta_per_segment),
+                sin_T = theta_per_segment - sq_theta_per_segment * theta_per_segment / 6,
+                cos_T = 1 - 0.5f * sq_theta_per_segment; // Small angle approximation
+  #endif
 
   #if DISABLED(AUTO_BED_LEVELING_UBL)
     ARC_LIJK_CODE(
@@ -268,6 +329,14 @@ void plan_arc(
     int8_t arc_recalc_count = N_ARC_CORRECTION;
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    // Queue the chords in groups, each as one block, if nothing bends the arc
+    const bool arc_blocks = can_buffer_arc({ center_P, center_Q }, radius, cart);
+    xyze_pos_t chord_ends[(ARC_BLOCK_CHORDS) + 1];
+    chord_ends[0] = current_position;
+    uint8_t chords = 0;
+  #endif
+
   for (uint16_t i = 1; i < segments; i++) { // Iterate (segments-1) times
 
     thermalManager.manage_heater();
@@ -318,6 +387,18 @@ void plan_arc(
       planner.apply_leveling(raw);
     #endif
 
+    #if ENABLED(ARC_BLOCKS)
+      if (arc_blocks) {
+        chord_ends[++chords] = raw;
+        if (chords < ARC_BLOCK_CHORDS) continue;
+        const bool queued = buffer_arc_chords(chord_ends, chords, scaled_fr_mm_s);
+        chord_ends[0] = raw;
+        chords = 0;
+        if (queued) continue;
+        break;
+      }
+    #endif
+
     if (!planner.buffer_line(raw, scaled_fr_mm_s, active_extruder, 0 OPTARG(SCARA_FEEDRATE_SCALING, inv_duration)))
       break;
   }
@@ -334,6 +415,13 @@ void plan_arc(
     planner.apply_leveling(raw);
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc_blocks) {
+      chord_ends[++chords] = raw;
+      buffer_arc_chords(chord_ends, chords, scaled_fr_mm_s);
+    }
+    else
+  #endif
   planner.buffer_line(raw, scaled_fr_mm_s, active_extruder, 0 OPTARG(SCARA_FEEDRATE_SCALING, inv_duration));
 
   #if ENABLED(AUTO_BED_LEVELING_UBL)
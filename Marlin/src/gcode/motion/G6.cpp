@@ -28,6 +28,7 @@
 
 #include "../gcode.h"
 #include "../../module/planner.h"
+#include "../../MarlinCore.h"
 
 /**
  * G6: Direct Stepper Move
@@ -52,6 +53,22 @@ void GcodeSuite::G6() {
 
   const page_idx_t page_idx = (page_idx_t) parser.value_ulong();
 
+  // A streamed page may still be arriving or waiting to be decoded. Fail one that stops arriving.
+  const millis_t page_timeout_ms = millis() + (STEPPER_PAGE_TIMEOUT);
+  while (page_manager.page_state(page_idx) == DirectStepping::PageState::WRITING) {
+    if (ELAPSED(millis(), page_timeout_ms)) {
+      page_manager.fail_page(page_idx);
+      break;
+    }
+    idle();
+  }
+
+  // Don't step a page that failed. The host resends it with another G6.
+  if (page_manager.page_state(page_idx) == DirectStepping::PageState::FAIL) {
+    SERIAL_ERROR_MSG("Bad page ", int(page_idx));
+    return;
+  }
+
   uint16_t num_steps = DirectStepping::Config::TOTAL_STEPS;
   if (parser.seen('S')) num_steps = parser.value_ushort();
 
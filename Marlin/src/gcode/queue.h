@@ -71,13 +71,20 @@ public:
     uint8_t length,                 //!< Number of commands in the queue
             index_r,                //!< Ring buffer's read position
             index_w;                //!< Ring buffer's write position
-    CommandLine commands[BUFSIZE];  //!< The ring buffer of commands
+    #if ENABLED(BUFFER_ARENA)
+      uint8_t size;                 //!< Number of commands that fit, set by M577
+      CommandLine *commands;        //!< The ring buffer of commands, in the shared arena
+    #else
+      CommandLine commands[BUFSIZE];  //!< The ring buffer of commands
+    #endif
+
+    inline uint8_t capacity() const { return TERN(BUFFER_ARENA, size, BUFSIZE); }
 
     inline serial_index_t command_port() const { return TERN0(HAS_MULTI_SERIAL, commands[index_r].port); }
 
     inline void clear() { length = index_r = index_w = 0; }
 
-    void advance_pos(uint8_t &p, const int inc) { if (++p >= BUFSIZE) p = 0; length += inc; }
+    void advance_pos(uint8_t &p, const int inc) { if (++p >= capacity()) p = 0; length += inc; }
 
     void commit_command(bool skip_ok
       OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind = serial_index_t())
@@ -89,7 +96,7 @@ public:
 
     void ok_to_send();
 
-    inline bool full(uint8_t cmdCount=1) const { return length > (BUFSIZE - cmdCount); }
+    inline bool full(uint8_t cmdCount=1) const { return length > (capacity() - cmdCount); }
 
     inline bool occupied() const { return length != 0; }
 
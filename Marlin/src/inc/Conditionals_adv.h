@@ -902,6 +902,14 @@
   #endif
 #endif
 
+#if EITHER(INPUT_SHAPING_X, INPUT_SHAPING_Y)
+  #define HAS_SHAPING 1
+#endif
+
+#if ENABLED(ARC_BLOCKS) && !defined(ARC_BLOCK_CHORDS)
+  #define ARC_BLOCK_CHORDS 8
+#endif
+
 #if ENABLED(DIRECT_STEPPING)
   #ifndef STEPPER_PAGES
     #define STEPPER_PAGES 16
@@ -912,6 +920,12 @@
   #ifndef PAGE_MANAGER
     #define PAGE_MANAGER SerialPageManager
   #endif
+  #ifndef STEPPER_PAGE_TIMEOUT
+    #define STEPPER_PAGE_TIMEOUT 2000
+  #endif
+  #if ENABLED(DIRECT_STEPPING_COMPRESSION) && !defined(DIRECT_STEPPING_DECODE_BUFFERS)
+    #define DIRECT_STEPPING_DECODE_BUFFERS 2
+  #endif
 #endif
 
 // Remove unused STEALTHCHOP flags
@@ -214,6 +214,7 @@
  */
 #if IS_SCARA
   #undef SLOWDOWN
+  #undef SLOWDOWN_BY_TIME
   #if DISABLED(AXEL_TPARA)
     #define QUICK_HOME
   #endif
@@ -295,6 +296,12 @@
 #if ENABLED(DELTA)
   #undef Z_SAFE_HOMING
   #undef SLOWDOWN
+  #undef SLOWDOWN_BY_TIME
+#endif
+
+// The planner keeps a running total of the queued move time
+#if EITHER(HAS_WIRED_LCD, SLOWDOWN_BY_TIME)
+  #define HAS_BLOCK_RUNTIME 1
 #endif
 
 #ifndef MESH_INSET
@@ -1253,6 +1253,75 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #endif
 #endif
 
+#if ENABLED(S_CURVE_TABLE) && DISABLED(S_CURVE_ACCELERATION)
+  #error "S_CURVE_TABLE requires S_CURVE_ACCELERATION."
+#endif
+
+/**
+ * Input Shaping requirements
+ */
+#if HAS_SHAPING
+  #if !IS_FULL_CARTESIAN
+    #error "INPUT_SHAPING_X and INPUT_SHAPING_Y require a Cartesian (non-Core) machine."
+  #elif ENABLED(DUAL_X_CARRIAGE)
+    #error "INPUT_SHAPING_X and INPUT_SHAPING_Y are incompatible with DUAL_X_CARRIAGE."
+  #elif ENABLED(DIRECT_STEPPING)
+    #error "INPUT_SHAPING_X and INPUT_SHAPING_Y are incompatible with DIRECT_STEPPING."
+  #elif ENABLED(I2S_STEPPER_STREAM)
+    #error "INPUT_SHAPING_X and INPUT_SHAPING_Y are incompatible with I2S_STEPPER_STREAM."
+  #elif ENABLED(BABYSTEP_XY)
+    #error "INPUT_SHAPING_X and INPUT_SHAPING_Y are incompatible with BABYSTEP_XY."
+  #elif !WITHIN(SHAPING_MIN_FREQ, 1, 500)
+    #error "SHAPING_MIN_FREQ must be between 1 and 500."
+  #elif SHAPING_MAX_STEPRATE / SHAPING_MIN_FREQ > 2000
+    #error "SHAPING_MAX_STEPRATE / SHAPING_MIN_FREQ must be 2000 or less to fit the shaping queues in RAM."
+  #endif
+  #if ENABLED(INPUT_SHAPING_X)
+    static_assert(SHAPING_FREQ_X == 0 || SHAPING_FREQ_X >= SHAPING_MIN_FREQ, "SHAPING_FREQ_X must be 0 or at least SHAPING_MIN_FREQ.");
+    static_assert(WITHIN(SHAPING_ZETA_X, 0, 1), "SHAPING_ZETA_X must be between 0 and 1.");
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    static_assert(SHAPING_FREQ_Y == 0 || SHAPING_FREQ_Y >= SHAPING_MIN_FREQ, "SHAPING_FREQ_Y must be 0 or at least SHAPING_MIN_FREQ.");
+    static_assert(WITHIN(SHAPING_ZETA_Y, 0, 1), "SHAPING_ZETA_Y must be between 0 and 1.");
+  #endif
+#endif
+
+/**
+ * Step Compiler requirements
+ */
+#if ENABLED(STEP_COMPILER)
+  #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+    #error "STEP_COMPILER is incompatible with ADAPTIVE_STEP_SMOOTHING."
+  #elif ENABLED(DIRECT_STEPPING)
+    #error "STEP_COMPILER is incompatible with DIRECT_STEPPING."
+  #elif ENABLED(MIXING_EXTRUDER)
+    #error "STEP_COMPILER is incompatible with MIXING_EXTRUDER."
+  #elif ENABLED(LASER_POWER_INLINE_TRAPEZOID)
+    #error "STEP_COMPILER is incompatible with LASER_POWER_INLINE_TRAPEZOID."
+  #elif HAS_SHAPING
+    #error "STEP_COMPILER is incompatible with INPUT_SHAPING_X and INPUT_SHAPING_Y."
+  #elif !WITHIN(STEP_EVENT_BUFFER_SIZE, 16, 256) || !IS_POWER_OF_2(STEP_EVENT_BUFFER_SIZE)
+    #error "STEP_EVENT_BUFFER_SIZE must be a power of 2 from 16 to 256."
+  #endif
+#endif
+
+/**
+ * Collinear move merging requirements
+ */
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  #if IS_KINEMATIC
+    #error "MERGE_COLLINEAR_MOVES is not compatible with kinematic machines."
+  #elif ENABLED(LASER_POWER_INLINE)
+    #error "MERGE_COLLINEAR_MOVES is incompatible with LASER_POWER_INLINE."
+  #elif !defined(MERGE_COLLINEAR_TOLERANCE) || !defined(MERGE_COLLINEAR_E_RATIO)
+    #error "MERGE_COLLINEAR_MOVES requires MERGE_COLLINEAR_TOLERANCE and MERGE_COLLINEAR_E_RATIO."
+  #elif !defined(MERGE_COLLINEAR_AHEAD) || !defined(MERGE_COLLINEAR_MIN_TIME)
+    #error "MERGE_COLLINEAR_MOVES requires MERGE_COLLINEAR_AHEAD and MERGE_COLLINEAR_MIN_TIME."
+  #elif MERGE_COLLINEAR_AHEAD < 1 || MERGE_COLLINEAR_AHEAD > (BLOCK_BUFFER_SIZE) - 2
+    #error "MERGE_COLLINEAR_AHEAD must be from 1 to (BLOCK_BUFFER_SIZE - 2)."
+  #endif
+#endif
+
 /**
  * Special tool-changing options
  */
@@ -1413,6 +1482,54 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "FOAMCUTTER_XYUV requires LINEAR_AXES >= 5."
 #endif
 
+/**
+ * Direct Stepping page pool
+ */
+#if ENABLED(DIRECT_STEPPING)
+  #if STEPPER_PAGES < 4 || STEPPER_PAGES > 252 || STEPPER_PAGES % 4
+    #error "STEPPER_PAGES must be a multiple of 4, from 4 to 252."
+  #elif ENABLED(DIRECT_STEPPING_COMPRESSION) && DIRECT_STEPPING_DECODE_BUFFERS != 1 && DIRECT_STEPPING_DECODE_BUFFERS != 2 && DIRECT_STEPPING_DECODE_BUFFERS != 4 && DIRECT_STEPPING_DECODE_BUFFERS != 8
+    #error "DIRECT_STEPPING_DECODE_BUFFERS must be 1, 2, 4, or 8."
+  #endif
+#endif
+
+/**
+ * Arc segmentation
+ */
+#ifdef ARC_CHORD_TOLERANCE
+  #if DISABLED(ARC_SUPPORT)
+    #error "ARC_CHORD_TOLERANCE requires ARC_SUPPORT."
+  #elif ARC_SEGMENTS_PER_SEC
+    #error "ARC_CHORD_TOLERANCE and ARC_SEGMENTS_PER_SEC are incompatible. Choose one."
+  #elif !(ARC_CHORD_TOLERANCE > 0)
+    #error "ARC_CHORD_TOLERANCE must be greater than 0."
+  #endif
+#endif
+#if ENABLED(ARC_BLOCKS)
+  #if DISABLED(ARC_SUPPORT)
+    #error "ARC_BLOCKS requires ARC_SUPPORT."
+  #elif !WITHIN(ARC_BLOCK_CHORDS, 1, 255)
+    #error "ARC_BLOCK_CHORDS must be from 1 to 255."
+  #elif !IS_FULL_CARTESIAN || EITHER(MARKFORGED_XY, MARKFORGED_YX)
+    #error "ARC_BLOCKS requires a Cartesian (non-Core) machine."
+  #elif HAS_CLASSIC_JERK
+    #error "ARC_BLOCKS requires Junction Deviation. Disable CLASSIC_JERK."
+  #elif ENABLED(BACKLASH_COMPENSATION)
+    #error "ARC_BLOCKS is incompatible with BACKLASH_COMPENSATION."
+  #elif ENABLED(STEP_COMPILER)
+    #error "ARC_BLOCKS is incompatible with STEP_COMPILER."
+  #elif HAS_SHAPING
+    #error "ARC_BLOCKS is incompatible with INPUT_SHAPING_X and INPUT_SHAPING_Y."
+  #endif
+#endif
+#ifdef BEZIER_FLATNESS
+  #if DISABLED(BEZIER_CURVE_SUPPORT)
+    #error "BEZIER_FLATNESS requires BEZIER_CURVE_SUPPORT."
+  #elif !(BEZIER_FLATNESS > 0)
+    #error "BEZIER_FLATNESS must be greater than 0."
+  #endif
+#endif
+
 /**
  * Allow only extra axis codes that do not conflict with G-code parameter names
  */
@@ -1493,6 +1610,16 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "CLASSIC_JERK is required for DELTA and SCARA."
 #endif
 
+#ifdef KINEMATIC_SEGMENT_BATCH
+  #if !IS_KINEMATIC
+    #error "KINEMATIC_SEGMENT_BATCH requires DELTA, SCARA, or POLARGRAPH."
+  #elif defined(__AVR__)
+    #error "KINEMATIC_SEGMENT_BATCH requires a 32-bit MCU."
+  #elif !WITHIN(KINEMATIC_SEGMENT_BATCH, 2, 16)
+    #error "KINEMATIC_SEGMENT_BATCH must be from 2 to 16."
+  #endif
+#endif
+
 /**
  * Some things should not be used on Belt Printers
  */
@@ -1777,6 +1904,26 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   static_assert(DEFAULT_ZJERK > 0.1, "Low DEFAULT_ZJERK values are incompatible with mesh-based leveling.");
 #endif
 
+#ifdef LEVELED_MERGE_TOLERANCE
+  #if !HAS_MESH
+    #error "LEVELED_MERGE_TOLERANCE requires MESH_BED_LEVELING, AUTO_BED_LEVELING_BILINEAR, or AUTO_BED_LEVELING_UBL."
+  #elif IS_KINEMATIC
+    #error "LEVELED_MERGE_TOLERANCE is only for Cartesian machines."
+  #elif DISABLED(AUTO_BED_LEVELING_UBL) && DISABLED(SEGMENT_LEVELED_MOVES)
+    #error "LEVELED_MERGE_TOLERANCE requires SEGMENT_LEVELED_MOVES with MESH_BED_LEVELING or AUTO_BED_LEVELING_BILINEAR."
+  #elif !(LEVELED_MERGE_TOLERANCE > 0)
+    #error "LEVELED_MERGE_TOLERANCE must be greater than 0."
+  #endif
+#endif
+
+#if ENABLED(ABL_BILINEAR_FIXED_POINT)
+  #if DISABLED(ABL_BILINEAR_PATCHES)
+    #error "ABL_BILINEAR_FIXED_POINT requires ABL_BILINEAR_PATCHES."
+  #elif ENABLED(EXTRAPOLATE_BEYOND_GRID)
+    #error "ABL_BILINEAR_FIXED_POINT is not compatible with EXTRAPOLATE_BEYOND_GRID."
+  #endif
+#endif
+
 #if ENABLED(G26_MESH_VALIDATION)
   #if !HAS_EXTRUDERS
     #error "G26_MESH_VALIDATION requires at least one extruder."
@@ -3374,6 +3521,14 @@ static_assert(_PLUS_TEST(4), "HOMING_FEEDRATE_MM_M values must be positive.");
   #error "A very large BLOCK_BUFFER_SIZE is not needed and takes longer to drain the buffer on pause / cancel."
 #endif
 
+#if ENABLED(BUFFER_ARENA)
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    #error "BUFFER_ARENA is incompatible with POWER_LOSS_RECOVERY."
+  #elif BUFSIZE < 2
+    #error "BUFFER_ARENA requires a BUFSIZE of at least 2."
+  #endif
+#endif
+
 #if ENABLED(LED_CONTROL_MENU) && !IS_ULTIPANEL
   #error "LED_CONTROL_MENU requires an LCD controller."
 #endif
@@ -3846,6 +4001,10 @@ static_assert(_PLUS_TEST(4), "HOMING_FEEDRATE_MM_M values must be positive.");
   #endif
 #endif
 
+#if ENABLED(PLANNER_BENCHMARK) && !defined(__PLAT_LINUX__)
+  #error "PLANNER_BENCHMARK is only supported by the LINUX HAL. Build with env:linux_native_benchmark."
+#endif
+
 // Misc. Cleanup
 #undef _TEST_PWM
 #undef _LINEAR_AXES_STR
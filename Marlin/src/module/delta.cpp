@@ -117,6 +117,36 @@ void inverse_kinematics(const xyz_pos_t &raw) {
   #endif
 }
 
+#ifdef KINEMATIC_SEGMENT_BATCH
+
+  /**
+   * Delta Inverse Kinematics for a batch of positions,
+   * storing the results in the abce[] array.
+   *
+   * Each tower's position and rod length (with the hotend
+   * offset folded in) are loaded once for the batch. The
+   * radicands are worked out in one loop and the square
+   * roots taken in another, so the first loop is free of
+   * library calls and can be unrolled or vectorized.
+   */
+  void _O3 inverse_kinematics(const xyze_pos_t raw[], abce_pos_t abce[], const uint8_t count) {
+    float radicand[KINEMATIC_SEGMENT_BATCH];
+    LOOP_ABC(t) {
+      const float tower_x = delta_tower[t].x TERN_(HAS_HOTEND_OFFSET, + hotend_offset[active_extruder].x),
+                  tower_y = delta_tower[t].y TERN_(HAS_HOTEND_OFFSET, + hotend_offset[active_extruder].y),
+                  rod_2 = delta_diagonal_rod_2_tower[t];
+      for (uint8_t i = 0; i < count; i++)
+        radicand[i] = rod_2 - HYPOT2(tower_x - raw[i].x, tower_y - raw[i].y);
+      for (uint8_t i = 0; i < count; i++)
+        abce[i][t] = raw[i].z + SQRT(radicand[i]);
+    }
+    #if HAS_EXTRUDERS
+      for (uint8_t i = 0; i < count; i++) abce[i].e = raw[i].e;
+    #endif
+  }
+
+#endif
+
 /**
  * Calculate the highest Z position where the
  * effector has the full range of XY motion.
@@ -0,0 +1,85 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * input_shaping.cpp - Input shaping for the X and Y steppers
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if HAS_SHAPING
+
+#include "input_shaping.h"
+
+/**
+ * Impulses of the standard shapers for a damped period Td:
+ *   ZV  : 1, K           at 0, Td/2
+ *   ZVD : 1, 2K, K^2     at 0, Td/2, Td
+ *   MZV : a, (√2-1)K, aK^2 at 0, 3Td/8, 3Td/4  (K with 3/4 of the ZV exponent, a = 1-1/√2)
+ * normalized to a sum of one step.
+ */
+void AxisShaper::calculate(const shaping_settings_t &s, shaping_params_t &p) {
+  float a[SHAPING_MAX_IMPULSES], t[SHAPING_MAX_IMPULSES] = { 0 };
+
+  if (s.frequency <= 0) {
+    p.impulses = 1;
+    a[0] = 1;
+  }
+  else {
+    const float df = SQRT(1 - sq(s.zeta)),
+                td = 1 / (s.frequency * df);
+    switch (s.type) {
+      default:
+      case ShapingType::ZV: {
+        const float k = expf(-s.zeta * M_PI / df);
+        p.impulses = 2;
+        a[0] = 1; a[1] = k;
+        t[1] = 0.5f * td;
+      } break;
+      case ShapingType::ZVD: {
+        const float k = expf(-s.zeta * M_PI / df);
+        p.impulses = 3;
+        a[0] = 1; a[1] = 2 * k; a[2] = sq(k);
+        t[1] = 0.5f * td; t[2] = td;
+      } break;
+      case ShapingType::MZV: {
+        const float k = expf(-0.75f * s.zeta * M_PI / df), a1 = 1 - M_SQRT1_2;
+        p.impulses = 3;
+        a[0] = a1; a[1] = (M_SQRT2 - 1) * k; a[2] = a1 * sq(k);
+        t[1] = 0.375f * td; t[2] = 0.75f * td;
+      } break;
+    }
+  }
+
+  float sum = 0;
+  LOOP_L_N(i, p.impulses) sum += a[i];
+
+  // The last impulse takes the rounding so a step always adds up to ONE
+  int32_t total = 0;
+  LOOP_L_N(i, p.impulses) {
+    p.amplitude[i] = i < p.impulses - 1 ? LROUND(a[i] / sum * ONE) : ONE - total;
+    p.delay[i] = LROUND(t[i] * (STEPPER_TIMER_RATE));
+    total += p.amplitude[i];
+  }
+}
+
+#endif // HAS_SHAPING
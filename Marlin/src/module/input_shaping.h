@@ -0,0 +1,133 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * input_shaping.h - Input shaping for the X and Y steppers
+ *
+ * Each commanded step is split into two or three impulses whose amplitudes
+ * add up to one step and whose delays cancel the frame's resonance. The
+ * shaped position is the sum of all impulses delivered so far, and a motor
+ * step is taken whenever it moves half a step away from the motor position.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+enum class ShapingType : uint8_t { ZV, ZVD, MZV };
+
+typedef struct {
+  ShapingType type;
+  float frequency,  // (Hz) 0 to disable shaping for the axis
+        zeta;       // Damping ratio
+} shaping_settings_t;
+
+#define SHAPING_MAX_IMPULSES 3
+
+// Steps held for the longest shaper (ZVD spans a full period) at the lowest frequency
+#define SHAPING_QUEUE_SIZE ((SHAPING_MAX_STEPRATE) / (SHAPING_MIN_FREQ) + 1)
+
+typedef IF<(SHAPING_QUEUE_SIZE > 255), uint16_t, uint8_t>::type shaping_index_t;
+
+// Fixed-point impulses used by the stepper ISR
+typedef struct {
+  uint8_t impulses;
+  int32_t amplitude[SHAPING_MAX_IMPULSES];  // Share of a step, with AxisShaper::ONE as a whole step
+  uint32_t delay[SHAPING_MAX_IMPULSES];     // (ticks) after the commanded step
+} shaping_params_t;
+
+class AxisShaper {
+public:
+  static constexpr int32_t ONE = _BV32(16), HALF = ONE / 2;
+
+  shaping_settings_t settings;
+
+  // Calculate the impulses for the settings. Only change them while idle().
+  static void calculate(const shaping_settings_t &s, shaping_params_t &p);
+  FORCE_INLINE void set_params(const shaping_params_t &p) {
+    params = p;
+    LOOP_L_N(i, SHAPING_MAX_IMPULSES) tail[i] = head;
+  }
+
+  // Nothing left to deliver?
+  FORCE_INLINE bool idle() const { return tail[params.impulses - 1] == head; }
+
+  // Queue a commanded step made at the given time. With no room the step is
+  // delivered whole, so the position is kept even if the shaping isn't.
+  FORCE_INLINE void push(const uint32_t now, const bool reverse) {
+    const shaping_index_t next = next_index(head);
+    if (next == tail[params.impulses - 1]) { pending += reverse ? -ONE : +ONE; return; }
+    queue[head] = (now & ~1UL) | reverse;
+    head = next;
+    queued += reverse ? -ONE : +ONE;
+  }
+
+  // Apply the impulses due by the given time. Return the motor steps to take.
+  FORCE_INLINE int16_t due_steps(const uint32_t now) {
+    LOOP_L_N(i, params.impulses) {
+      shaping_index_t &t = tail[i];
+      while (t != head && int32_t(now - (queue[t] & ~1UL) - params.delay[i]) >= 0) {
+        const int32_t a = (queue[t] & 1) ? -params.amplitude[i] : params.amplitude[i];
+        pending += a;
+        queued -= a;
+        t = next_index(t);
+      }
+    }
+    int16_t steps = 0;
+    while (pending >= HALF) { pending -= ONE; steps++; }
+    while (pending < -HALF) { pending += ONE; steps--; }
+    return steps;
+  }
+
+  // Ticks until the next impulse is due, or 0xFFFFFFFF for none
+  FORCE_INLINE uint32_t next_due(const uint32_t now) const {
+    uint32_t due = 0xFFFFFFFF;
+    LOOP_L_N(i, params.impulses) if (tail[i] != head) {
+      const int32_t ticks = int32_t((queue[tail[i]] & ~1UL) + params.delay[i] - now);
+      NOMORE(due, uint32_t(_MAX(ticks, 0)));
+    }
+    return due;
+  }
+
+  // Drop everything not yet delivered, as when the move is aborted.
+  // Return the commanded steps the motor will now never take. The
+  // commanded and motor positions are whole steps, so this is exact.
+  FORCE_INLINE int32_t flush() {
+    const int32_t undelivered = (queued + pending) / ONE;
+    LOOP_L_N(i, SHAPING_MAX_IMPULSES) tail[i] = head;
+    queued = pending = 0;
+    if (has_staged) { params = staged; has_staged = false; }
+    return undelivered;
+  }
+
+  bool dir_reverse;                         // Last direction written to the DIR pin
+  bool has_staged;                          // New impulses waiting for the queue to empty
+  shaping_params_t staged;
+
+private:
+  static FORCE_INLINE shaping_index_t next_index(const shaping_index_t i) { return i + 1 < SHAPING_QUEUE_SIZE ? i + 1 : 0; }
+
+  shaping_params_t params = { 1, { ONE }, { 0 } }; // Unshaped until set
+  int32_t pending,                          // Shaped position minus the motor position
+          queued;                           // Commanded position minus the shaped position
+  uint32_t queue[SHAPING_QUEUE_SIZE];       // Commanded step times. Bit 0 is set for reverse steps.
+  shaping_index_t head, tail[SHAPING_MAX_IMPULSES];
+};
@@ -145,6 +145,17 @@ xyz_pos_t cartes;
 
   abce_pos_t delta;
 
+  #if defined(KINEMATIC_SEGMENT_BATCH) && DISABLED(DELTA)
+    // SCARA and POLARGRAPH solve one position at a time
+    void inverse_kinematics(const xyze_pos_t raw[], abce_pos_t abce[], const uint8_t count) {
+      LOOP_L_N(i, count) {
+        inverse_kinematics(raw[i]);
+        abce[i] = delta;
+        TERN_(HAS_EXTRUDERS, abce[i].e = raw[i].e);
+      }
+    }
+  #endif
+
   #if HAS_SCARA_OFFSET
     abc_pos_t scara_home_offset;
   #endif
@@ -981,11 +992,23 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
 
     // Calculate and execute the segments
     millis_t next_idle_ms = millis() + 200UL;
-    while (--segments) {
-      segment_idle(next_idle_ms);
-      raw += segment_distance;
-      if (!planner.buffer_line(raw, scaled_fr_mm_s, active_extruder, cartesian_segment_mm OPTARG(SCARA_FEEDRATE_SCALING, inv_duration))) break;
-    }
+    #ifdef KINEMATIC_SEGMENT_BATCH
+      // Hand the segments to the planner a batch at a time
+      xyze_pos_t batch[KINEMATIC_SEGMENT_BATCH];
+      for (uint16_t left = segments - 1; left;) {
+        segment_idle(next_idle_ms);
+        const uint8_t count = _MIN(left, uint16_t(KINEMATIC_SEGMENT_BATCH));
+        LOOP_L_N(i, count) { raw += segment_distance; batch[i] = raw; }
+        if (planner.buffer_segments(batch, count, scaled_fr_mm_s, active_extruder, cartesian_segment_mm OPTARG(SCARA_FEEDRATE_SCALING, inv_duration)) < count) break;
+        left -= count;
+      }
+    #else
+      while (--segments) {
+        segment_idle(next_idle_ms);
+        raw += segment_distance;
+        if (!planner.buffer_line(raw, scaled_fr_mm_s, active_extruder, cartesian_segment_mm OPTARG(SCARA_FEEDRATE_SCALING, inv_duration))) break;
+      }
+    #endif
 
     // Ensure last segment arrives at target location.
     planner.buffer_line(destination, scaled_fr_mm_s, active_extruder, cartesian_segment_mm OPTARG(SCARA_FEEDRATE_SCALING, inv_duration));
@@ -1042,17 +1065,35 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
       // Get the raw current position as starting point
       xyze_pos_t raw = current_position;
 
+      #ifdef LEVELED_MERGE_TOLERANCE
+        // The correction the planner will apply at a point
+        auto correction = [](const xyze_pos_t &pos) { xyz_pos_t lev = pos; planner.apply_leveling(lev); return lev.z - pos.z; };
+        // Merged segments are longer, so let the planner work out each length
+        auto buffer = [&](const xyze_pos_t &pos) { return planner.buffer_line(pos, fr_mm_s, active_extruder); };
+        LeveledMerge merge;
+        merge.start(raw, correction(raw));
+        UNUSED(cartesian_segment_mm);
+      #endif
+
       // Calculate and execute the segments
       millis_t next_idle_ms = millis() + 200UL;
       while (--segments) {
         segment_idle(next_idle_ms);
         raw += segment_distance;
-        if (!planner.buffer_line(raw, fr_mm_s, active_extruder, cartesian_segment_mm OPTARG(SCARA_FEEDRATE_SCALING, inv_duration))) break;
+        #ifdef LEVELED_MERGE_TOLERANCE
+          if (!merge.add(raw, correction(raw), buffer)) break;
+        #else
+          if (!planner.buffer_line(raw, fr_mm_s, active_extruder, cartesian_segment_mm OPTARG(SCARA_FEEDRATE_SCALING, inv_duration))) break;
+        #endif
       }
 
       // Since segment_distance is only approximate,
       // the final move must be to the exact destination.
-      planner.buffer_line(destination, fr_mm_s, active_extruder, cartesian_segment_mm OPTARG(SCARA_FEEDRATE_SCALING, inv_duration));
+      #ifdef LEVELED_MERGE_TOLERANCE
+        if (merge.add(destination, correction(destination), buffer)) merge.flush(buffer);
+      #else
+        planner.buffer_line(destination, fr_mm_s, active_extruder, cartesian_segment_mm OPTARG(SCARA_FEEDRATE_SCALING, inv_duration));
+      #endif
     }
 
   #endif // SEGMENT_LEVELED_MOVES
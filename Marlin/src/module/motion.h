@@ -54,6 +54,10 @@ extern xyz_pos_t cartes;
 // Until kinematics.cpp is created, declare this here
 #if IS_KINEMATIC
   extern abce_pos_t delta;
+  #ifdef KINEMATIC_SEGMENT_BATCH
+    // Inverse kinematics for 'count' positions, with E passed through
+    void inverse_kinematics(const xyze_pos_t raw[], abce_pos_t abce[], const uint8_t count);
+  #endif
 #endif
 
 #if HAS_ABL_NOT_UBL
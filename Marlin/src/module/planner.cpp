@@ -118,7 +118,12 @@ Planner planner;
 /**
  * A ring buffer of moves described in steps
  */
-block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
+#if ENABLED(BUFFER_ARENA)
+  block_t *Planner::block_buffer;
+  uint8_t Planner::block_buffer_mask;
+#else
+  block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
+#endif
 volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
                  Planner::block_buffer_nonbusy, // Index of the first non-busy block
                  Planner::block_buffer_planned, // Index of the optimally planned block
@@ -208,6 +213,18 @@ uint32_t Planner::acceleration_long_cutoff;
 xyze_float_t Planner::previous_speed;
 float Planner::previous_nominal_speed_sqr;
 
+#if HAS_JUNCTION_DEVIATION
+  xyze_float_t Planner::prev_unit_vec;
+#endif
+
+#if HAS_CLASSIC_JERK
+  float Planner::previous_safe_speed;
+#endif
+
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  Planner::merge_state_t Planner::merge;
+#endif
+
 #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
   last_move_t Planner::g_uc_extruder_last_move[E_STEPPERS] = { 0 };
 #endif
@@ -230,8 +247,9 @@ float Planner::previous_nominal_speed_sqr;
   xyze_pos_t Planner::position_cart;
 #endif
 
-#if HAS_WIRED_LCD
-  volatile uint32_t Planner::block_buffer_runtime_us = 0;
+#if HAS_BLOCK_RUNTIME
+  uint32_t Planner::block_buffer_runtime_us = 0;
+  volatile uint32_t Planner::block_buffer_runtime_taken_us = 0;
 #endif
 
 /**
@@ -735,31 +753,90 @@ block_t* Planner::get_current_block() {
       delay_before_delivering = 0;
     }
 
-    // If we are here, there is no excuse to deliver the block
-    block_t * const block = &block_buffer[block_buffer_tail];
+    #if ENABLED(STEP_COMPILER)
 
-    // No trapezoid calculated? Don't execute yet.
-    if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
+      // Only deliver blocks that the step compiler already took
+      return block_buffer_tail != acquire_index(block_buffer_nonbusy) ? &block_buffer[block_buffer_tail] : nullptr;
 
-    // We can't be sure how long an active block will take, so don't count it.
-    TERN_(HAS_WIRED_LCD, block_buffer_runtime_us -= block->segment_time_us);
+    #else
+
+      // If we are here, there is no excuse to deliver the block
+      block_t * const block = &block_buffer[block_buffer_tail];
+
+      // No trapezoid calculated? Don't execute yet.
+      if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
+
+      // As this block is busy, advance the nonbusy block pointer
+      release_index(block_buffer_nonbusy, next_block_index(block_buffer_tail));
+
+      // The main loop may have claimed the block since. If so, give it back.
+      BLOCK_FENCE();  // claim_block() sets the flag, then looks for the block. Do the reverse.
+      if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) {
+        release_index(block_buffer_nonbusy, block_buffer_tail);
+        return nullptr;
+      }
+
+      // We can't be sure how long an active block will take, so don't count it.
+      TERN_(HAS_BLOCK_RUNTIME, block_buffer_runtime_taken_us += block->segment_time_us);
+
+      // Push block_buffer_planned pointer, if encountered.
+      if (block_buffer_tail == block_buffer_planned)
+        block_buffer_planned = block_buffer_nonbusy;
+
+      // Return the block
+      return block;
+
+    #endif
+  }
+
+  return nullptr;
+}
+
+#if ENABLED(STEP_COMPILER)
+
+  /**
+   * Get the next block for the step compiler
+   * and mark the block as busy.
+   * Return nullptr if there are no more blocks,
+   * if there is a first-block delay, or if the
+   * next block's trapezoid isn't calculated.
+   *
+   * The ISR only takes blocks handed out here,
+   * so the range from tail to nonbusy is busy.
+   *
+   * WARNING: Called from ISR contexts!
+   */
+  block_t* Planner::get_compile_block() {
+    const uint8_t nonbusy = block_buffer_nonbusy;
+    if (delay_before_delivering || nonbusy == acquire_index(block_buffer_head)) return nullptr;
+
+    block_t * const block = &block_buffer[nonbusy];
+
+    // No trapezoid calculated? Don't compile yet.
+    if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
 
     // As this block is busy, advance the nonbusy block pointer
-    block_buffer_nonbusy = next_block_index(block_buffer_tail);
+    const uint8_t next_nonbusy = next_block_index(nonbusy);
+    release_index(block_buffer_nonbusy, next_nonbusy);
+
+    // The main loop may have claimed the block since. If so, give it back.
+    BLOCK_FENCE();
+    if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) {
+      release_index(block_buffer_nonbusy, nonbusy);
+      return nullptr;
+    }
+
+    // We can't be sure how long an active block will take, so don't count it.
+    TERN_(HAS_BLOCK_RUNTIME, block_buffer_runtime_taken_us += block->segment_time_us);
 
     // Push block_buffer_planned pointer, if encountered.
-    if (block_buffer_tail == block_buffer_planned)
-      block_buffer_planned = block_buffer_nonbusy;
+    if (nonbusy == block_buffer_planned)
+      block_buffer_planned = next_nonbusy;
 
-    // Return the block
     return block;
   }
 
-  // The queue became empty
-  TERN_(HAS_WIRED_LCD, clear_block_buffer_runtime()); // paranoia. Buffer is empty now - so reset accumulated time to zero.
-
-  return nullptr;
-}
+#endif
 
 /**
  * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
@@ -776,6 +853,9 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
   uint32_t initial_rate = CEIL(block->nominal_rate * entry_factor),
            final_rate = CEIL(block->nominal_rate * exit_factor); // (steps per second)
 
+  // Advance steps due to exit speed
+  TERN_(LIN_ADVANCE, if (block->use_advance_lead) block->final_adv_steps = advance_steps(block, final_rate));
+
   // Limit minimal step rate (Otherwise the timer will overflow.)
   NOLESS(initial_rate, uint32_t(MINIMAL_STEP_RATE));
   NOLESS(final_rate, uint32_t(MINIMAL_STEP_RATE));
@@ -784,11 +864,18 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
     uint32_t cruise_rate = initial_rate;
   #endif
 
-  const int32_t accel = block->acceleration_steps_per_s2;
+  #if DISABLED(FIXED_POINT_TRAPEZOIDS) || ENABLED(S_CURVE_ACCELERATION)
+    const int32_t accel = block->acceleration_steps_per_s2;
+  #endif
 
           // Steps required for acceleration, deceleration to/from nominal rate
-  uint32_t accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel)),
-           decelerate_steps = FLOOR(estimate_acceleration_distance(block->nominal_rate, final_rate, -accel));
+  #if ENABLED(FIXED_POINT_TRAPEZOIDS)
+    uint32_t accelerate_steps = estimate_acceleration_steps(block, initial_rate, block->nominal_rate),
+             decelerate_steps = estimate_deceleration_steps(block, block->nominal_rate, final_rate);
+  #else
+    uint32_t accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel)),
+             decelerate_steps = FLOOR(estimate_acceleration_distance(block->nominal_rate, final_rate, -accel));
+  #endif
           // Steps between acceleration and deceleration, if any
   int32_t plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
 
@@ -797,8 +884,12 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
   // Use intersection_distance() to calculate accel / braking time in order to
   // reach the final_rate exactly at the end of this block.
   if (plateau_steps < 0) {
-    const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
-    accelerate_steps = _MIN(uint32_t(_MAX(accelerate_steps_float, 0)), block->step_event_count);
+    #if ENABLED(FIXED_POINT_TRAPEZOIDS)
+      accelerate_steps = intersection_steps(block, initial_rate, final_rate);
+    #else
+      const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
+      accelerate_steps = _MIN(uint32_t(_MAX(accelerate_steps_float, 0)), block->step_event_count);
+    #endif
     plateau_steps = 0;
 
     #if ENABLED(S_CURVE_ACCELERATION)
@@ -963,23 +1054,11 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
         : _MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-current->acceleration, next ? next->entry_speed_sqr : sq(float(MINIMUM_PLANNER_SPEED)), current->millimeters));
       if (current->entry_speed_sqr != new_entry_speed_sqr) {
 
-        // Need to recalculate the block speed - Mark it now, so the stepper
-        // ISR does not consume the block before being recalculated
-        SBI(current->flag, BLOCK_BIT_RECALCULATE);
-
-        // But there is an inherent race condition here, as the block may have
-        // become BUSY just before being marked RECALCULATE, so check for that!
-        if (stepper.is_block_busy(current)) {
-          // Block became busy. Clear the RECALCULATE flag (no point in
-          // recalculating BUSY blocks). And don't set its speed, as it can't
-          // be updated at this time.
-          CBI(current->flag, BLOCK_BIT_RECALCULATE);
-        }
-        else {
-          // Block is not BUSY so this is ahead of the Stepper ISR:
-          // Just Set the new entry speed.
+        // Need to recalculate the block speed - Claim it now, so the stepper
+        // ISR does not consume the block before being recalculated. If the block
+        // is already BUSY its speed can't be updated at this time.
+        if (claim_block(current))
           current->entry_speed_sqr = new_entry_speed_sqr;
-        }
       }
     }
   }
@@ -1051,21 +1130,9 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
       if (new_entry_speed_sqr < current->entry_speed_sqr) {
 
         // Mark we need to recompute the trapezoidal shape, and do it now,
-        // so the stepper ISR does not consume the block before being recalculated
-        SBI(current->flag, BLOCK_BIT_RECALCULATE);
-
-        // But there is an inherent race condition here, as the block maybe
-        // became BUSY, just before it was marked as RECALCULATE, so check
-        // if that is the case!
-        if (stepper.is_block_busy(current)) {
-          // Block became busy. Clear the RECALCULATE flag (no point in
-          //  recalculating BUSY blocks and don't set its speed, as it can't
-          //  be updated at this time.
-          CBI(current->flag, BLOCK_BIT_RECALCULATE);
-        }
-        else {
-          // Block is not BUSY, we won the race against the Stepper ISR:
-
+        // so the stepper ISR does not consume the block before being recalculated.
+        // A BUSY block can't be updated at this time.
+        if (claim_block(current)) {
           // Always <= max_entry_speed_sqr. Backward pass sets this.
           current->entry_speed_sqr = new_entry_speed_sqr; // Always <= max_entry_speed_sqr. Backward pass sets this.
 
@@ -1113,7 +1180,7 @@ void Planner::forward_pass() {
       // the previous block became BUSY, so assume the current block's
       // entry speed can't be altered (since that would also require
       // updating the exit speed of the previous block).
-      if (!previous || !stepper.is_block_busy(previous))
+      if (!previous || !is_block_busy(previous))
         forward_pass_kernel(previous, block, block_index);
       previous = block;
     }
@@ -1126,11 +1193,21 @@ void Planner::forward_pass() {
  * Recalculate the trapezoid speed profiles for all blocks in the plan
  * according to the entry_factor for each junction. Must be called by
  * recalculate() after updating the blocks.
+ *
+ * planned_block_index is block_buffer_planned as it was before the
+ * reverse and forward passes. Neither pass alters that block or any
+ * block before it, so their trapezoids are final and the scan can
+ * begin with the block whose exit speed is that block's entry speed.
  */
-void Planner::recalculate_trapezoids() {
+void Planner::recalculate_trapezoids(const uint8_t planned_block_index) {
   // The tail may be changed by the ISR so get a local copy.
-  uint8_t block_index = block_buffer_tail,
+  uint8_t block_index = acquire_index(block_buffer_tail),
           head_block_index = block_buffer_head;
+
+  // Start just before the stable watermark, unless the ISR has already consumed it
+  const uint8_t stable_blocks = BLOCK_MOD(planned_block_index - block_index);
+  if (stable_blocks && stable_blocks <= BLOCK_MOD(head_block_index - block_index))
+    block_index = prev_block_index(planned_block_index);
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
@@ -1164,33 +1241,18 @@ void Planner::recalculate_trapezoids() {
         // Recalculate if current block entry or exit junction speed has changed.
         if (TEST(block->flag, BLOCK_BIT_RECALCULATE) || TEST(next->flag, BLOCK_BIT_RECALCULATE)) {
 
-          // Mark the current block as RECALCULATE, to protect it from the Stepper ISR running it.
+          // Claim the current block, to protect it from the Stepper ISR running it.
           // Note that due to the above condition, there's a chance the current block isn't marked as
-          // RECALCULATE yet, but the next one is. That's the reason for the following line.
-          SBI(block->flag, BLOCK_BIT_RECALCULATE);
-
-          // But there is an inherent race condition here, as the block maybe
-          // became BUSY, just before it was marked as RECALCULATE, so check
-          // if that is the case!
-          if (!stepper.is_block_busy(block)) {
-            // Block is not BUSY, we won the race against the Stepper ISR:
-
+          // RECALCULATE yet, but the next one is. A BUSY block is left as it is.
+          if (claim_block(block)) {
             // NOTE: Entry and exit factors always > 0 by all previous logic operations.
             const float current_nominal_speed = SQRT(block->nominal_speed_sqr),
                         nomr = 1.0f / current_nominal_speed;
             calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
-            #if ENABLED(LIN_ADVANCE)
-              if (block->use_advance_lead) {
-                const float comp = block->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
-                block->max_adv_steps = current_nominal_speed * comp;
-                block->final_adv_steps = next_entry_speed * comp;
-              }
-            #endif
-          }
 
-          // Reset current only to ensure next trapezoid is computed - The
-          // stepper is free to use the block from now on.
-          CBI(block->flag, BLOCK_BIT_RECALCULATE);
+            // Hand the block back - The stepper is free to use the block from now on.
+            unclaim_block(block);
+          }
         }
       }
 
@@ -1204,44 +1266,35 @@ void Planner::recalculate_trapezoids() {
   // Last/newest block in buffer. Exit speed is set with MINIMUM_PLANNER_SPEED. Always recalculated.
   if (next) {
 
-    // Mark the next(last) block as RECALCULATE, to prevent the Stepper ISR running it.
+    // Claim the next(last) block, to prevent the Stepper ISR running it.
     // As the last block is always recalculated here, there is a chance the block isn't
-    // marked as RECALCULATE yet. That's the reason for the following line.
-    SBI(next->flag, BLOCK_BIT_RECALCULATE);
-
-    // But there is an inherent race condition here, as the block maybe
-    // became BUSY, just before it was marked as RECALCULATE, so check
-    // if that is the case!
-    if (!stepper.is_block_busy(block)) {
-      // Block is not BUSY, we won the race against the Stepper ISR:
-
+    // marked as RECALCULATE yet. A BUSY block is left as it is.
+    if (claim_block(next)) {
       const float next_nominal_speed = SQRT(next->nominal_speed_sqr),
                   nomr = 1.0f / next_nominal_speed;
       calculate_trapezoid_for_block(next, next_entry_speed * nomr, float(MINIMUM_PLANNER_SPEED) * nomr);
-      #if ENABLED(LIN_ADVANCE)
-        if (next->use_advance_lead) {
-          const float comp = next->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
-          next->max_adv_steps = next_nominal_speed * comp;
-          next->final_adv_steps = (MINIMUM_PLANNER_SPEED) * comp;
-        }
-      #endif
-    }
 
-    // Reset next only to ensure its trapezoid is computed - The stepper is free to use
-    // the block from now on.
-    CBI(next->flag, BLOCK_BIT_RECALCULATE);
+      // Hand the block back - The stepper is free to use the block from now on.
+      unclaim_block(next);
+    }
   }
 }
 
 void Planner::recalculate() {
+  TERN_(PLANNER_BENCHMARK, const PlannerBenchmark::Probe probe(PlannerBenchmark::recalculate));
+
+  // Blocks up to the optimal plan pointer can't change. The ISR may push
+  // the pointer along, but the passes below only ever move it forward.
+  const uint8_t planned_block_index = block_buffer_planned;
+
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
   // If there is just one block, no planning can be done. Avoid it!
-  if (block_index != block_buffer_planned) {
+  if (block_index != planned_block_index) {
     reverse_pass();
     forward_pass();
   }
-  recalculate_trapezoids();
+  recalculate_trapezoids(planned_block_index);
 }
 
 #if HAS_FAN && DISABLED(LASER_SYNCHRONOUS_M106_M107)
@@ -1666,11 +1719,17 @@ void Planner::quick_stop() {
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
+  // Drop the steps already compiled from them
+  TERN_(STEP_COMPILER, stepper.flush_step_events());
+
+  // Drop the shaped steps still to be taken
+  TERN_(HAS_SHAPING, stepper.flush_shaping());
+
   // Restart the block delay for the first movement - As the queue was
   // forced to empty, there's no risk the ISR will touch this.
   delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
 
-  #if HAS_WIRED_LCD
+  #if HAS_BLOCK_RUNTIME
     // Clear the accumulated runtime
     clear_block_buffer_runtime();
   #endif
@@ -1772,7 +1831,10 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 /**
  * Block until the planner is finished processing
  */
-void Planner::synchronize() { while (busy()) idle(); }
+void Planner::synchronize() {
+  // Shaped steps are still being taken after the last block is done
+  while (busy() || TERN0(HAS_SHAPING, !stepper.shaping_idle())) idle();
+}
 
 /**
  * Planner::_buffer_steps
@@ -1784,6 +1846,7 @@ void Planner::synchronize() { while (busy()) idle(); }
  *  fr_mm_s       - (target) speed of the move
  *  extruder      - target extruder
  *  millimeters   - the length of the movement, if known
+ *  arc           - the chords of an arc in XY, for an arc block
  *
  * Returns true if movement was properly queued, false otherwise (if cleaning)
  */
@@ -1791,28 +1854,78 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   OPTARG(HAS_POSITION_FLOAT, const xyze_pos_t &target_float)
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters
+  OPTARG(ARC_BLOCKS, const arc_chords_t * const arc)
 ) {
 
-  // Wait for the next available block
   uint8_t next_buffer_head;
-  block_t * const block = get_next_free_block(next_buffer_head);
 
-  // If we are cleaning, do not accept queuing of movements
-  // This must be after get_next_free_block() because it calls idle()
-  // where cleaning_buffer_counter can be changed
-  if (cleaning_buffer_counter) return false;
+  #if ENABLED(MERGE_COLLINEAR_MOVES)
+
+    // Take back the last block if this move continues it in a straight line
+    float block_mm = millimeters;
+    block_t *block = TERN0(ARC_BLOCKS, arc) ? nullptr : reopen_collinear_block(target, fr_mm_s, extruder, block_mm, next_buffer_head);
+    const bool merged = block;
+
+    if (!merged) {
+      // Wait for the next available block
+      block = get_next_free_block(next_buffer_head);
+
+      // If we are cleaning, do not accept queuing of movements
+      // This must be after get_next_free_block() because it calls idle()
+      // where cleaning_buffer_counter can be changed
+      if (cleaning_buffer_counter) return false;
+
+      // Save the state the block starts from, to merge more moves into it
+      merge.block_index = block_buffer_head;
+      merge.extruder = extruder;
+      merge.fr_mm_s = fr_mm_s;
+      merge.millimeters = millimeters;
+      merge.deviation = 0;
+      merge.position = position;
+      TERN_(HAS_POSITION_FLOAT, merge.position_float = position_float);
+      merge.previous_speed = previous_speed;
+      merge.previous_nominal_speed_sqr = previous_nominal_speed_sqr;
+      TERN_(HAS_JUNCTION_DEVIATION, merge.prev_unit_vec = prev_unit_vec);
+      TERN_(HAS_CLASSIC_JERK, merge.previous_safe_speed = previous_safe_speed);
+      TERN_(DISABLE_INACTIVE_EXTRUDER, COPY(merge.extruder_last_move, g_uc_extruder_last_move));
+      #if ENABLED(BACKLASH_COMPENSATION)
+        merge.backlash_direction_bits = backlash.last_direction_bits;
+        #ifdef BACKLASH_SMOOTHING_MM
+          merge.backlash_residual_error = backlash.residual_error;
+        #endif
+      #endif
+    }
+
+  #else
+
+    // Wait for the next available block
+    block_t * const block = get_next_free_block(next_buffer_head);
+
+    // If we are cleaning, do not accept queuing of movements
+    // This must be after get_next_free_block() because it calls idle()
+    // where cleaning_buffer_counter can be changed
+    if (cleaning_buffer_counter) return false;
+
+  #endif
+
+  TERN_(PLANNER_BENCHMARK, const PlannerBenchmark::Probe probe(PlannerBenchmark::plan));
 
   // Fill the block with the specified movement
   if (!_populate_block(block, false, target
     OPTARG(HAS_POSITION_FLOAT, target_float)
     OPTARG(HAS_DIST_MM_ARG, cart_dist_mm)
-    , fr_mm_s, extruder, millimeters
+    , fr_mm_s, extruder, TERN(MERGE_COLLINEAR_MOVES, block_mm, millimeters)
+    OPTARG(ARC_BLOCKS, arc)
   )) {
     // Movement was not queued, probably because it was too short.
     //  Simply accept that as movement queued and done
     return true;
   }
 
+  #if BOTH(MERGE_COLLINEAR_MOVES, POWER_LOSS_RECOVERY)
+    if (merged) block->sdpos = merge.sdpos;
+  #endif
+
   // If this is the first added movement, reload the delay, otherwise, cancel it.
   if (block_buffer_head == block_buffer_tail) {
     // If it was the first queued block, restart the 1st block delivery delay, to
@@ -1823,8 +1936,8 @@ bool Planner::_buffer_steps(const xyze_long_t &target
     delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
   }
 
-  // Move buffer head
-  block_buffer_head = next_buffer_head;
+  // Move buffer head, publishing the block to the Stepper ISR
+  release_index(block_buffer_head, next_buffer_head);
 
   // Recalculate and optimize trapezoidal speed profiles
   recalculate();
@@ -1833,6 +1946,265 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   return true;
 }
 
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+
+  /**
+   * Planner::reopen_collinear_block
+   *
+   * If the move to 'target' continues the last queued block in a straight line, take
+   * that block back off the queue and restore the planner state from before it, so it
+   * can be populated again from its start to the new target.
+   *
+   * Only a block with MERGE_COLLINEAR_AHEAD blocks queued ahead of it, and MERGE_COLLINEAR_MIN_TIME
+   * of moves where the runtime is tracked, is taken back. That covers the time to populate it again.
+   * If the Stepper ISR reaches the block anyway, it waits on the claim until the block is back.
+   *
+   * Returns the block to populate again, or nullptr
+   */
+  block_t* Planner::reopen_collinear_block(const xyze_long_t &target, const_feedRate_t fr_mm_s, const uint8_t extruder, float &millimeters, uint8_t &next_buffer_head) {
+    const uint8_t block_index = prev_block_index(block_buffer_head);
+    block_t * const block = &block_buffer[block_index];
+
+    // Only a move block queued with the same settings
+    if (block_index != merge.block_index || fr_mm_s != merge.fr_mm_s || extruder != merge.extruder) return nullptr;
+    if (block->flag & (BLOCK_MASK_SYNC | TERN0(DIRECT_STEPPING, BLOCK_FLAG_IS_PAGE) | TERN0(ARC_BLOCKS, BLOCK_FLAG_IS_ARC))) return nullptr;
+    #if HAS_FAN
+      FANS_LOOP(i) if (block->fan_speed[i] != thermalManager.fan_speed[i]) return nullptr;
+    #endif
+    #if HAS_CUTTER
+      if (block->cutter_power != cutter.power) return nullptr;
+    #endif
+
+    // The block so far (u) and the new move (v) must go the same way
+    float uu = 0, vv = 0, uv = 0;
+    LOOP_LINEAR_AXES(i) {
+      const float u = (position[i] - merge.position[i]) * mm_per_step[i],
+                  v = (target[i] - position[i]) * mm_per_step[i];
+      uu += sq(u); vv += sq(v); uv += u * v;
+    }
+    if (uv <= 0) return nullptr;
+
+    // Distance of the block end from the merged block is |u x v| / |u + v|. Earlier merged
+    // points move by no more than this, so the sum of these distances bounds them all.
+    const float deviation = merge.deviation + SQRT(_MAX(uu * vv - sq(uv), 0.0f) / (uu + 2 * uv + vv));
+    if (deviation > (MERGE_COLLINEAR_TOLERANCE)) return nullptr;
+
+    #if HAS_EXTRUDERS
+      // Keep the same extrusion per mm, so E stays proportional and Linear Advance applies alike
+      const float eu = (position.e - merge.position.e) * mm_per_step[E_AXIS_N(extruder)],
+                  ev = (target.e - position.e) * mm_per_step[E_AXIS_N(extruder)],
+                  eu_sq_vv = sq(eu) * vv, ev_sq_uu = sq(ev) * uu;
+      if (eu * ev < 0
+        || ev_sq_uu < sq(1.0f - (MERGE_COLLINEAR_E_RATIO)) * eu_sq_vv
+        || ev_sq_uu > sq(1.0f + (MERGE_COLLINEAR_E_RATIO)) * eu_sq_vv
+      ) return nullptr;
+    #endif
+
+    // Take the block off the queue, unless the Stepper ISR could get to it soon.
+    // The claim keeps the ISR off it if the ISR gets there in the meantime.
+    if (nonbusy_movesplanned() <= (MERGE_COLLINEAR_AHEAD)) return nullptr;
+    #if HAS_BLOCK_RUNTIME
+      if (queued_runtime_us() < block->segment_time_us + (MERGE_COLLINEAR_MIN_TIME)) return nullptr;
+    #endif
+    if (!claim_block(block)) return nullptr;
+    next_buffer_head = block_buffer_head;
+    release_index(block_buffer_head, block_index);
+    // The ISR only moves the planned pointer past a block it takes, so it won't move it from the head
+    if (block_buffer_planned == next_buffer_head) block_buffer_planned = block_index;
+    TERN_(HAS_BLOCK_RUNTIME, block_buffer_runtime_us -= block->segment_time_us);
+
+    // Restore the state the block started from
+    position = merge.position;
+    TERN_(HAS_POSITION_FLOAT, position_float = merge.position_float);
+    previous_speed = merge.previous_speed;
+    previous_nominal_speed_sqr = merge.previous_nominal_speed_sqr;
+    TERN_(HAS_JUNCTION_DEVIATION, prev_unit_vec = merge.prev_unit_vec);
+    TERN_(HAS_CLASSIC_JERK, previous_safe_speed = merge.previous_safe_speed);
+    TERN_(DISABLE_INACTIVE_EXTRUDER, COPY(g_uc_extruder_last_move, merge.extruder_last_move)); // Count the block down once
+    #if ENABLED(BACKLASH_COMPENSATION)
+      backlash.last_direction_bits = merge.backlash_direction_bits;
+      #ifdef BACKLASH_SMOOTHING_MM
+        backlash.residual_error = merge.backlash_residual_error;
+      #endif
+    #endif
+    TERN_(POWER_LOSS_RECOVERY, merge.sdpos = block->sdpos);
+
+    merge.deviation = deviation;
+    merge.millimeters = millimeters = (merge.millimeters && millimeters) ? merge.millimeters + millimeters : 0;
+
+    return block;
+  }
+
+#endif // MERGE_COLLINEAR_MOVES
+
+#if HAS_JUNCTION_DEVIATION
+
+  /**
+   * The max. speed² through the junction of two unit vectors by junction deviation,
+   * for a block with the given acceleration and length
+   */
+  float Planner::junction_speed_sqr(const xyze_float_t &prev_unit_vec, const xyze_float_t &unit_vec, const_float_t acceleration, const_float_t millimeters) {
+    float vmax_junction_sqr;
+
+    // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
+    // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
+    float junction_cos_theta = LOGICAL_AXIS_GANG(
+                               + (-prev_unit_vec.e * unit_vec.e),
+                                 (-prev_unit_vec.x * unit_vec.x),
+                               + (-prev_unit_vec.y * unit_vec.y),
+                               + (-prev_unit_vec.z * unit_vec.z),
+                               + (-prev_unit_vec.i * unit_vec.i),
+                               + (-prev_unit_vec.j * unit_vec.j),
+                               + (-prev_unit_vec.k * unit_vec.k)
+                             );
+
+    // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
+    if (junction_cos_theta > 0.999999f) {
+      // For a 0 degree acute junction, just set minimum junction speed.
+      vmax_junction_sqr = sq(float(MINIMUM_PLANNER_SPEED));
+    }
+    else {
+      NOLESS(junction_cos_theta, -0.999999f); // Check for numerical round-off to avoid divide by zero.
+
+      // Convert delta vector to unit vector
+      xyze_float_t junction_unit_vec = unit_vec - prev_unit_vec;
+
+      #if ENABLED(JD_FAST_MATH)
+
+        /**
+         * For unit vectors |u - p|^2 = 2 + 2 * cos(theta) = 4 * (1 - sin^2(theta/2)), so
+         *   sin / (1 - sin) = sin * (1 + sin) / (1 - sin^2) = 4 * sin * (1 + sin) / |u - p|^2
+         * This avoids the cancellation in (1 - sin) for nearly straight junctions, and with
+         * 1 / |u - p| from fast_rsqrt it needs no SQRT or division. Likewise sin^2(theta/2)
+         * is |u + p|^2 / 4, which doesn't cancel near a reversal.
+         */
+        float junction_len_sq = 0, junction_sum_sq = 0;
+        LOOP_LOGICAL_AXES(idx) {
+          junction_len_sq += sq(junction_unit_vec[idx]);
+          junction_sum_sq += sq(unit_vec[idx] + prev_unit_vec[idx]);
+        }
+        NOLESS(junction_len_sq, 0.000002f); // Same limit as junction_cos_theta >= -0.999999
+        const float junction_len_inv = fast_rsqrt(junction_len_sq);
+        junction_unit_vec *= junction_len_inv;
+
+        const float junction_acceleration = limit_value_by_axis_maximum(acceleration, junction_unit_vec),
+                    sin_theta_d2_sq = _MAX(0.25f * junction_sum_sq, 0.0000005f), // Trig half angle identity
+                    sin_theta_d2 = sin_theta_d2_sq * fast_rsqrt(sin_theta_d2_sq);
+
+        vmax_junction_sqr = 4.0f * junction_acceleration * junction_deviation_mm * sin_theta_d2 * (1.0f + sin_theta_d2) * sq(junction_len_inv);
+
+      #else
+
+        normalize_junction_vector(junction_unit_vec);
+
+        const float junction_acceleration = limit_value_by_axis_maximum(acceleration, junction_unit_vec),
+                    sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
+
+        vmax_junction_sqr = junction_acceleration * junction_deviation_mm * sin_theta_d2 / (1.0f - sin_theta_d2);
+
+      #endif
+
+      #if ENABLED(JD_HANDLE_SMALL_SEGMENTS)
+
+        // For small moves with >135° junction (octagon) find speed for approximate arc
+        if (millimeters < 1 && junction_cos_theta < -0.7071067812f) {
+
+          #if ENABLED(JD_FAST_MATH)
+
+            // The angle between the segments is 2 * asin(|u - p| / 2). Up to 45° the
+            // series through x^5 is within 0.0005 rad.
+            const float junction_len = junction_len_sq * junction_len_inv,
+                        junction_theta = junction_len * (1.0f + junction_len_sq * (1.0f / 24 + junction_len_sq * (3.0f / 640)));
+
+          #elif ENABLED(JD_USE_MATH_ACOS)
+
+            #error "TODO: Inline maths with the MCU / FPU."
+
+          #elif ENABLED(JD_USE_LOOKUP_TABLE)
+
+            // Fast acos approximation (max. error +-0.01 rads)
+            // Based on LUT table and linear interpolation
+
+            /**
+             *  // Generate the JD Lookup Table
+             *  constexpr float c = 1.00751495f; // Correction factor to center error around 0
+             *  for (int i = 0; i < jd_lut_count - 1; ++i) {
+             *    const float x0 = (sq(i) - 1) / sq(i),
+             *                y0 = acos(x0) * (i == 0 ? 1 : c),
+             *                x1 = i < jd_lut_count - 1 ?  0.5 * x0 + 0.5 : 0.999999f,
+             *                y1 = acos(x1) * (i < jd_lut_count - 1 ? c : 1);
+             *    jd_lut_k[i] = (y0 - y1) / (x0 - x1);
+             *    jd_lut_b[i] = (y1 * x0 - y0 * x1) / (x0 - x1);
+             *  }
+             *
+             *  // Compute correction factor (Set c to 1.0f first!)
+             *  float min = INFINITY, max = -min;
+             *  for (float t = 0; t <= 1; t += 0.0003f) {
+             *    const float e = acos(t) / approx(t);
+             *    if (isfinite(e)) {
+             *      if (e < min) min = e;
+             *      if (e > max) max = e;
+             *    }
+             *  }
+             *  fprintf(stderr, "%.9gf, ", (min + max) / 2);
+             */
+            static constexpr int16_t  jd_lut_count = 16;
+            static constexpr uint16_t jd_lut_tll   = _BV(jd_lut_count - 1);
+            static constexpr int16_t  jd_lut_tll0  = __builtin_clz(jd_lut_tll) + 1; // i.e., 16 - jd_lut_count + 1
+            static constexpr float jd_lut_k[jd_lut_count] PROGMEM = {
+              -1.03145837f, -1.30760646f, -1.75205851f, -2.41705704f,
+              -3.37769222f, -4.74888992f, -6.69649887f, -9.45661736f,
+              -13.3640480f, -18.8928222f, -26.7136841f, -37.7754593f,
+              -53.4201813f, -75.5458374f, -106.836761f, -218.532821f };
+            static constexpr float jd_lut_b[jd_lut_count] PROGMEM = {
+               1.57079637f,  1.70887053f,  2.04220939f,  2.62408352f,
+               3.52467871f,  4.85302639f,  6.77020454f,  9.50875854f,
+               13.4009285f,  18.9188995f,  26.7321243f,  37.7885055f,
+               53.4293975f,  75.5523529f,  106.841369f,  218.534011f };
+
+            const float neg = junction_cos_theta < 0 ? -1 : 1,
+                        t = neg * junction_cos_theta;
+
+            const int16_t idx = (t < 0.00000003f) ? 0 : __builtin_clz(uint16_t((1.0f - t) * jd_lut_tll)) - jd_lut_tll0;
+
+            float junction_theta = t * pgm_read_float(&jd_lut_k[idx]) + pgm_read_float(&jd_lut_b[idx]);
+            if (neg > 0) junction_theta = RADIANS(180) - junction_theta; // acos(-t)
+
+          #else
+
+            // Fast acos(-t) approximation (max. error +-0.033rad = 1.89°)
+            // Based on MinMax polynomial published by W. Randolph Franklin, see
+            // https://wrf.ecse.rpi.edu/Research/Short_Notes/arcsin/onlyelem.html
+            //  acos( t) = pi / 2 - asin(x)
+            //  acos(-t) = pi - acos(t) ... pi / 2 + asin(x)
+
+            const float neg = junction_cos_theta < 0 ? -1 : 1,
+                        t = neg * junction_cos_theta,
+                        asinx =       0.032843707f
+                              + t * (-1.451838349f
+                              + t * ( 29.66153956f
+                              + t * (-131.1123477f
+                              + t * ( 262.8130562f
+                              + t * (-242.7199627f
+                              + t * ( 84.31466202f ) ))))),
+                        junction_theta = RADIANS(90) + neg * asinx; // acos(-t)
+
+            // NOTE: junction_theta bottoms out at 0.033 which avoids divide by 0.
+
+          #endif
+
+          const float limit_sqr = (millimeters * junction_acceleration) / junction_theta;
+          NOMORE(vmax_junction_sqr, limit_sqr);
+        }
+
+      #endif // JD_HANDLE_SMALL_SEGMENTS
+    }
+
+    return vmax_junction_sqr;
+  }
+
+#endif // HAS_JUNCTION_DEVIATION
+
 /**
  * Planner::_populate_block
  *
@@ -1841,6 +2213,7 @@ bool Planner::_buffer_steps(const xyze_long_t &target
  *  target      - target position in steps units
  *  fr_mm_s     - (target) speed of the move
  *  extruder    - target extruder
+ *  arc         - the chords of an arc in XY, for an arc block
  *
  * Returns true if movement is acceptable, false otherwise
  */
@@ -1849,6 +2222,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   OPTARG(HAS_POSITION_FLOAT, const xyze_pos_t &target_float)
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters/*=0.0*/
+  OPTARG(ARC_BLOCKS, const arc_chords_t * const arc/*=nullptr*/)
 ) {
   int32_t LOGICAL_AXIS_LIST(
     de = target.e - position.e,
@@ -1979,6 +2353,13 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   // Set direction bits
   block->direction_bits = dm;
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) {
+      block->flag = BLOCK_FLAG_IS_ARC;
+      block->arc = arc->steps;
+    }
+  #endif
+
   // Update block laser power
   #if ENABLED(LASER_POWER_INLINE)
     laser_inline.status.isPlanned = true;
@@ -2005,6 +2386,17 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     block->steps.set(LINEAR_AXIS_LIST(ABS(da), ABS(db), ABS(dc), ABS(di), ABS(dj), ABS(dk)));
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    /**
+     * X and Y each move as fast as the head somewhere on an arc, so plan them both
+     * for the whole length of the chords. The Stepper ISR steps each chord exactly.
+     */
+    if (arc) {
+      block->steps.x = CEIL(arc->xy_mm * settings.axis_steps_per_mm[X_AXIS]);
+      block->steps.y = CEIL(arc->xy_mm * settings.axis_steps_per_mm[Y_AXIS]);
+    }
+  #endif
+
   /**
    * This part of the code calculates the total length of the movement.
    * For cartesian bots, the X_AXIS is the real X movement and same for Y_AXIS.
@@ -2069,17 +2461,20 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
   TERN_(HAS_EXTRUDERS, steps_dist_mm.e = esteps_float * mm_per_step[E_AXIS_N(extruder)]);
 
+  TERN_(ARC_BLOCKS, if (arc) steps_dist_mm.x = steps_dist_mm.y = arc->xy_mm);
+
   TERN_(LCD_SHOW_E_TOTAL, e_move_accumulator += steps_dist_mm.e);
 
-  if (true LINEAR_AXIS_GANG(
+  // Moves with too few linear steps take their length from E
+  const bool short_linear = true LINEAR_AXIS_GANG(
       && block->steps.a < MIN_STEPS_PER_SEGMENT,
       && block->steps.b < MIN_STEPS_PER_SEGMENT,
       && block->steps.c < MIN_STEPS_PER_SEGMENT,
       && block->steps.i < MIN_STEPS_PER_SEGMENT,
       && block->steps.j < MIN_STEPS_PER_SEGMENT,
       && block->steps.k < MIN_STEPS_PER_SEGMENT
-    )
-  ) {
+    );
+  if (short_linear) {
     block->millimeters = TERN0(HAS_EXTRUDERS, ABS(steps_dist_mm.e));
   }
   else {
@@ -2136,6 +2531,18 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     esteps, block->steps.a, block->steps.b, block->steps.c, block->steps.i, block->steps.j, block->steps.k
   ));
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) {
+      // Share the step events out to the chords, giving each chord at least one
+      // step event for each step of its longest axis
+      block_arc_t &chords = block->arc;
+      uint32_t chord_events = (block->step_event_count + chords.chords - 1) / chords.chords;
+      LOOP_L_N(i, chords.chords) NOLESS(chord_events, uint32_t(_MAX(ABS(chords.chord[i].x), ABS(chords.chord[i].y))));
+      chords.chord_events = chord_events;
+      block->step_event_count = chord_events * chords.chords;
+    }
+  #endif
+
   // Bail if this is a zero-length block
   if (block->step_event_count < MIN_STEPS_PER_SEGMENT) return false;
 
@@ -2228,7 +2635,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         #define ENABLE_ONE_E(N) do{ \
           if (N == E_STEPPER_INDEX(extruder) || _IS_DUPE(N)) {    /* N is 'extruder', or N is duplicating */ \
             stepper.ENABLE_EXTRUDER(N);                           /* Enable the relevant E stepper... */ \
-            g_uc_extruder_last_move[N] = (BLOCK_BUFFER_SIZE) * 2; /* ...and reset its counter */ \
+            g_uc_extruder_last_move[N] = TERN(BUFFER_ARENA, block_buffer_mask + 1, BLOCK_BUFFER_SIZE) * 2; /* ...and reset its counter */ \
           } \
           else if (!g_uc_extruder_last_move[N])                   /* Counter expired since last E stepper enable */ \
             stepper.DISABLE_EXTRUDER(N);                          /* Disable the E stepper */ \
@@ -2259,7 +2666,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   const uint8_t moves_queued = nonbusy_movesplanned();
 
   // Slow down when the buffer starts to empty, rather than wait at the corner for a buffer refill
-  #if EITHER(SLOWDOWN, HAS_WIRED_LCD) || defined(XY_FREQUENCY_LIMIT)
+  #if ENABLED(SLOWDOWN) || HAS_BLOCK_RUNTIME || defined(XY_FREQUENCY_LIMIT)
     // Segment time im micro seconds
     int32_t segment_time_us = LROUND(1000000.0f / inverse_secs);
   #endif
@@ -2268,27 +2675,51 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     #ifndef SLOWDOWN_DIVISOR
       #define SLOWDOWN_DIVISOR 2
     #endif
-    if (WITHIN(moves_queued, 2, (BLOCK_BUFFER_SIZE) / (SLOWDOWN_DIVISOR) - 1)) {
-      const int32_t time_diff = settings.min_segment_time_us - segment_time_us;
-      if (time_diff > 0) {
-        // Buffer is draining so add extra time. The amount of time added increases if the buffer is still emptied more.
-        const int32_t nst = segment_time_us + LROUND(2 * time_diff / moves_queued);
-        inverse_secs = 1000000.0f / nst;
-        #if defined(XY_FREQUENCY_LIMIT) || HAS_WIRED_LCD
-          segment_time_us = nst;
-        #endif
+    #if ENABLED(SLOWDOWN_BY_TIME)
+
+      /**
+       * Keep the time that (buffer size / SLOWDOWN_DIVISOR) min_segment_time moves hold.
+       * Tiny segments start to slow down sooner than by block count, but only in
+       * proportion to the missing time, so the feedrate eases down instead of
+       * dropping once half the blocks are gone. A buffer the host keeps full is
+       * not draining, however little time it holds.
+       */
+      if (moves_queued >= 2 && moves_free() > 1) {
+        const int32_t time_diff = settings.min_segment_time_us - segment_time_us;
+        if (time_diff > 0) {
+          const uint32_t queued_us = queued_runtime_us() + segment_time_us;
+
+          const uint32_t horizon_us = settings.min_segment_time_us * (TERN(BUFFER_ARENA, block_buffer_mask + 1, BLOCK_BUFFER_SIZE) / (SLOWDOWN_DIVISOR));
+          if (queued_us < horizon_us) {
+            // Buffer is short of time so add extra time, up to min_segment_time with the buffer empty
+            const int32_t nst = segment_time_us + LROUND(float(time_diff) * (horizon_us - queued_us) / horizon_us);
+            inverse_secs = 1000000.0f / nst;
+            segment_time_us = nst;
+          }
+        }
       }
-    }
-  #endif
 
-  #if HAS_WIRED_LCD
-    // Protect the access to the position.
-    const bool was_enabled = stepper.suspend();
+    #else
 
+      if (WITHIN(moves_queued, 2, TERN(BUFFER_ARENA, block_buffer_mask + 1, BLOCK_BUFFER_SIZE) / (SLOWDOWN_DIVISOR) - 1)) {
+        const int32_t time_diff = settings.min_segment_time_us - segment_time_us;
+        if (time_diff > 0) {
+          // Buffer is draining so add extra time. The amount of time added increases if the buffer is still emptied more.
+          const int32_t nst = segment_time_us + LROUND(2 * time_diff / moves_queued);
+          inverse_secs = 1000000.0f / nst;
+          #if defined(XY_FREQUENCY_LIMIT) || HAS_BLOCK_RUNTIME
+            segment_time_us = nst;
+          #endif
+        }
+      }
+
+    #endif
+  #endif
+
+  #if HAS_BLOCK_RUNTIME
+    // Only the main loop adds to the queued runtime, so it needs no protection
     block_buffer_runtime_us += segment_time_us;
     block->segment_time_us = segment_time_us;
-
-    if (was_enabled) stepper.wake_up();
   #endif
 
   block->nominal_speed_sqr = sq(block->millimeters * inverse_secs);   // (mm/sec)^2 Always > 0
@@ -2430,28 +2861,24 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
        * extruder_advance_K[active_extruder] : There is an advance factor set for this extruder.
        *
        * de > 0             : Extruder is running forward (e.g., for "Wipe while retracting" (Slic3r) or "Combing" (Cura) moves)
+       *
+       * !short_linear      : The move has a length apart from E, so its extrusion per mm is known.
        */
       block->use_advance_lead =  esteps
                               && extruder_advance_K[active_extruder]
-                              && de > 0;
+                              && de > 0
+                              && !short_linear;
 
       if (block->use_advance_lead) {
-        block->e_D_ratio = (target_float.e - position_float.e) /
-          #if IS_KINEMATIC
-            block->millimeters
-          #else
-            SQRT(sq(target_float.x - position_float.x)
-               + sq(target_float.y - position_float.y)
-               + sq(target_float.z - position_float.z))
-          #endif
-        ;
+        // Extrusion per mm of the move, from the length already known
+        const float e_D_ratio = steps_dist_mm.e * inverse_millimeters;
 
         // Check for unusual high e_D ratio to detect if a retract move was combined with the last print move due to min. steps per segment. Never execute this with advance!
         // This assumes no one will use a retract length of 0mm < retr_length < ~0.2mm and no one will print 100mm wide lines using 3mm filament or 35mm wide lines using 1.75mm filament.
-        if (block->e_D_ratio > 3.0f)
+        if (e_D_ratio > 3.0f)
           block->use_advance_lead = false;
         else {
-          const uint32_t max_accel_steps_per_s2 = MAX_E_JERK(extruder) / (extruder_advance_K[active_extruder] * block->e_D_ratio) * steps_per_mm;
+          const uint32_t max_accel_steps_per_s2 = MAX_E_JERK(extruder) / (extruder_advance_K[active_extruder] * e_D_ratio) * steps_per_mm;
           if (TERN0(LA_DEBUG, accel > max_accel_steps_per_s2))
             SERIAL_ECHOLNPGM("Acceleration limited.");
           NOMORE(accel, max_accel_steps_per_s2);
@@ -2485,14 +2912,42 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   }
   block->acceleration_steps_per_s2 = accel;
   block->acceleration = accel / steps_per_mm;
+  #if ENABLED(ARC_BLOCKS)
+    xyze_float_t arc_entry_vec, arc_exit_vec;
+    if (arc) {
+      // The unit vector of a chord, with its share of the other axes
+      auto chord_unit_vec = [&](const xy_float_t &chord) {
+        xyze_float_t vec = LOGICAL_AXIS_ARRAY(
+          steps_dist_mm.e, chord.x * arc->steps.chords, chord.y * arc->steps.chords,
+          steps_dist_mm.z, steps_dist_mm.i, steps_dist_mm.j, steps_dist_mm.k
+        );
+        normalize_junction_vector(vec);
+        return vec;
+      };
+      arc_entry_vec = chord_unit_vec(arc->first);
+      arc_exit_vec = chord_unit_vec(arc->last);
+
+      // The chords all turn by the same angle, so one chord junction limits
+      // the speed on all of them, just as for the chords queued as lines
+      if (arc->steps.chords > 1) {
+        const float max_speed_sqr = junction_speed_sqr(arc_entry_vec, chord_unit_vec(arc->second), block->acceleration, block->millimeters / arc->steps.chords);
+        if (block->nominal_speed_sqr > max_speed_sqr) {
+          block->nominal_rate = CEIL(block->nominal_rate * SQRT(max_speed_sqr / block->nominal_speed_sqr));
+          block->nominal_speed_sqr = max_speed_sqr;
+        }
+      }
+    }
+  #endif
+  TERN_(FIXED_POINT_TRAPEZOIDS, set_acceleration_inverse(block));
   #if DISABLED(S_CURVE_ACCELERATION)
     block->acceleration_rate = (uint32_t)(accel * (sq(4096.0f) / (STEPPER_TIMER_RATE)));
   #endif
   #if ENABLED(LIN_ADVANCE)
     if (block->use_advance_lead) {
-      block->advance_speed = (STEPPER_TIMER_RATE) / (extruder_advance_K[active_extruder] * block->e_D_ratio * block->acceleration * settings.axis_steps_per_mm[E_AXIS_N(extruder)]);
+      set_advance_factor(block, extruder_advance_K[active_extruder], esteps, accel);
       #if ENABLED(LA_DEBUG)
-        if (extruder_advance_K[active_extruder] * block->e_D_ratio * block->acceleration * 2 < SQRT(block->nominal_speed_sqr) * block->e_D_ratio)
+        const float advance_factor = block->advance_factor * (1.0f / _BV32(24));
+        if (advance_factor * accel * 2 < float(block->nominal_rate) * esteps / block->step_event_count)
           SERIAL_ECHOLNPGM("More than 2 steps per eISR loop executed.");
         if (block->advance_speed < 200)
           SERIAL_ECHOLNPGM("eISR running at > 10kHz.");
@@ -2537,9 +2992,6 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
           can be spared, a better acos could be used. For all I know, it may be
           already calculated in a different place. */
 
-    // Unit vector of previous path line segment
-    static xyze_float_t prev_unit_vec;
-
     xyze_float_t unit_vec =
       #if HAS_DIST_MM_ARG
         cart_dist_mm
@@ -2548,12 +3000,17 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       #endif
     ;
 
+
     /**
      * On CoreXY the length of the vector [A,B] is SQRT(2) times the length of the head movement vector [X,Y].
      * So taking Z and E into account, we cannot scale to a unit vector with "inverse_millimeters".
      * => normalize the complete junction vector.
      * Elsewise, when needed JD will factor-in the E component
      */
+    #if ENABLED(ARC_BLOCKS)
+      if (arc) unit_vec = arc_entry_vec;    // An arc block starts along its first chord
+      else
+    #endif
     if (ANY(IS_CORE, MARKFORGED_XY, MARKFORGED_YX) || esteps > 0)
       normalize_junction_vector(unit_vec);  // Normalize with XYZE components
     else
@@ -2561,131 +3018,23 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
     // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
     if (moves_queued && !UNEAR_ZERO(previous_nominal_speed_sqr)) {
-      // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
-      // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
-      float junction_cos_theta = LOGICAL_AXIS_GANG(
-                                 + (-prev_unit_vec.e * unit_vec.e),
-                                   (-prev_unit_vec.x * unit_vec.x),
-                                 + (-prev_unit_vec.y * unit_vec.y),
-                                 + (-prev_unit_vec.z * unit_vec.z),
-                                 + (-prev_unit_vec.i * unit_vec.i),
-                                 + (-prev_unit_vec.j * unit_vec.j),
-                                 + (-prev_unit_vec.k * unit_vec.k)
-                               );
-
-      // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
-      if (junction_cos_theta > 0.999999f) {
-        // For a 0 degree acute junction, just set minimum junction speed.
-        vmax_junction_sqr = sq(float(MINIMUM_PLANNER_SPEED));
-      }
-      else {
-        NOLESS(junction_cos_theta, -0.999999f); // Check for numerical round-off to avoid divide by zero.
-
-        // Convert delta vector to unit vector
-        xyze_float_t junction_unit_vec = unit_vec - prev_unit_vec;
-        normalize_junction_vector(junction_unit_vec);
-
-        const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec),
-                    sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
-
-        vmax_junction_sqr = junction_acceleration * junction_deviation_mm * sin_theta_d2 / (1.0f - sin_theta_d2);
-
-        #if ENABLED(JD_HANDLE_SMALL_SEGMENTS)
-
-          // For small moves with >135° junction (octagon) find speed for approximate arc
-          if (block->millimeters < 1 && junction_cos_theta < -0.7071067812f) {
-
-            #if ENABLED(JD_USE_MATH_ACOS)
-
-              #error "TODO: Inline maths with the MCU / FPU."
-
-            #elif ENABLED(JD_USE_LOOKUP_TABLE)
-
-              // Fast acos approximation (max. error +-0.01 rads)
-              // Based on LUT table and linear interpolation
-
-              /**
-               *  // Generate the JD Lookup Table
-               *  constexpr float c = 1.00751495f; // Correction factor to center error around 0
-               *  for (int i = 0; i < jd_lut_count - 1; ++i) {
-               *    const float x0 = (sq(i) - 1) / sq(i),
-               *                y0 = acos(x0) * (i == 0 ? 1 : c),
-               *                x1 = i < jd_lut_count - 1 ?  0.5 * x0 + 0.5 : 0.999999f,
-               *                y1 = acos(x1) * (i < jd_lut_count - 1 ? c : 1);
-               *    jd_lut_k[i] = (y0 - y1) / (x0 - x1);
-               *    jd_lut_b[i] = (y1 * x0 - y0 * x1) / (x0 - x1);
-               *  }
-               *
-               *  // Compute correction factor (Set c to 1.0f first!)
-               *  float min = INFINITY, max = -min;
-               *  for (float t = 0; t <= 1; t += 0.0003f) {
-               *    const float e = acos(t) / approx(t);
-               *    if (isfinite(e)) {
-               *      if (e < min) min = e;
-               *      if (e > max) max = e;
-               *    }
-               *  }
-               *  fprintf(stderr, "%.9gf, ", (min + max) / 2);
-               */
-              static constexpr int16_t  jd_lut_count = 16;
-              static constexpr uint16_t jd_lut_tll   = _BV(jd_lut_count - 1);
-              static constexpr int16_t  jd_lut_tll0  = __builtin_clz(jd_lut_tll) + 1; // i.e., 16 - jd_lut_count + 1
-              static constexpr float jd_lut_k[jd_lut_count] PROGMEM = {
-                -1.03145837f, -1.30760646f, -1.75205851f, -2.41705704f,
-                -3.37769222f, -4.74888992f, -6.69649887f, -9.45661736f,
-                -13.3640480f, -18.8928222f, -26.7136841f, -37.7754593f,
-                -53.4201813f, -75.5458374f, -106.836761f, -218.532821f };
-              static constexpr float jd_lut_b[jd_lut_count] PROGMEM = {
-                 1.57079637f,  1.70887053f,  2.04220939f,  2.62408352f,
-                 3.52467871f,  4.85302639f,  6.77020454f,  9.50875854f,
-                 13.4009285f,  18.9188995f,  26.7321243f,  37.7885055f,
-                 53.4293975f,  75.5523529f,  106.841369f,  218.534011f };
-
-              const float neg = junction_cos_theta < 0 ? -1 : 1,
-                          t = neg * junction_cos_theta;
-
-              const int16_t idx = (t < 0.00000003f) ? 0 : __builtin_clz(uint16_t((1.0f - t) * jd_lut_tll)) - jd_lut_tll0;
-
-              float junction_theta = t * pgm_read_float(&jd_lut_k[idx]) + pgm_read_float(&jd_lut_b[idx]);
-              if (neg > 0) junction_theta = RADIANS(180) - junction_theta; // acos(-t)
-
-            #else
-
-              // Fast acos(-t) approximation (max. error +-0.033rad = 1.89°)
-              // Based on MinMax polynomial published by W. Randolph Franklin, see
-              // https://wrf.ecse.rpi.edu/Research/Short_Notes/arcsin/onlyelem.html
-              //  acos( t) = pi / 2 - asin(x)
-              //  acos(-t) = pi - acos(t) ... pi / 2 + asin(x)
-
-              const float neg = junction_cos_theta < 0 ? -1 : 1,
-                          t = neg * junction_cos_theta,
-                          asinx =       0.032843707f
-                                + t * (-1.451838349f
-                                + t * ( 29.66153956f
-                                + t * (-131.1123477f
-                                + t * ( 262.8130562f
-                                + t * (-242.7199627f
-                                + t * ( 84.31466202f ) ))))),
-                          junction_theta = RADIANS(90) + neg * asinx; // acos(-t)
-
-              // NOTE: junction_theta bottoms out at 0.033 which avoids divide by 0.
-
-            #endif
-
-            const float limit_sqr = (block->millimeters * junction_acceleration) / junction_theta;
-            NOMORE(vmax_junction_sqr, limit_sqr);
-          }
-
-        #endif // JD_HANDLE_SMALL_SEGMENTS
-      }
-
       // Get the lowest speed
-      vmax_junction_sqr = _MIN(vmax_junction_sqr, block->nominal_speed_sqr, previous_nominal_speed_sqr);
+      #if ENABLED(ARC_BLOCKS)
+        // An arc block joins the previous move with its first chord
+        const float junction_mm = arc ? block->millimeters / arc->steps.chords : block->millimeters;
+      #else
+        const float junction_mm = block->millimeters;
+      #endif
+      vmax_junction_sqr = _MIN(junction_speed_sqr(prev_unit_vec, unit_vec, block->acceleration, junction_mm), block->nominal_speed_sqr, previous_nominal_speed_sqr);
     }
     else // Init entry speed to zero. Assume it starts from rest. Planner will correct this later.
       vmax_junction_sqr = 0;
 
-    prev_unit_vec = unit_vec;
+    #if ENABLED(ARC_BLOCKS)
+      prev_unit_vec = arc ? arc_exit_vec : unit_vec;   // The next move joins the last chord
+    #else
+      prev_unit_vec = unit_vec;
+    #endif
 
   #endif
 
@@ -2705,9 +3054,6 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
      */
     CACHED_SQRT(nominal_speed, block->nominal_speed_sqr);
 
-    // Exit speed limited by a jerk to full halt of a previous last segment
-    static float previous_safe_speed;
-
     // Start with a safe speed (from which the machine may halt to stop immediately).
     float safe_speed = nominal_speed;
 
@@ -2867,7 +3213,7 @@ void Planner::buffer_sync_block(TERN_(LASER_SYNCHRONOUS_M106_M107, uint8_t sync_
     delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
   }
 
-  block_buffer_head = next_buffer_head;
+  release_index(block_buffer_head, next_buffer_head);
 
   stepper.wake_up();
 } // buffer_sync_block()
@@ -2883,12 +3229,14 @@ void Planner::buffer_sync_block(TERN_(LASER_SYNCHRONOUS_M106_M107, uint8_t sync_
  *  fr_mm_s     - (target) speed of the move
  *  extruder    - target extruder
  *  millimeters - the length of the movement, if known
+ *  arc         - the chords of an arc in XY, for an arc block
  *
  * Return 'false' if no segment was queued due to cleaning, cold extrusion, full queue, etc.
  */
 bool Planner::buffer_segment(const abce_pos_t &abce
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , const_feedRate_t fr_mm_s, const uint8_t extruder/*=active_extruder*/, const_float_t millimeters/*=0.0*/
+  OPTARG(ARC_BLOCKS, const arc_chords_t * const arc/*=nullptr*/)
 ) {
 
   // If we are cleaning, do not accept queuing of movements
@@ -2976,32 +3324,30 @@ bool Planner::buffer_segment(const abce_pos_t &abce
   if (!_buffer_steps(target
       OPTARG(HAS_POSITION_FLOAT, target_float)
       OPTARG(HAS_DIST_MM_ARG, cart_dist_mm)
-      , fr_mm_s, extruder, millimeters)
+      , fr_mm_s, extruder, millimeters
+      OPTARG(ARC_BLOCKS, arc))
   ) return false;
 
   stepper.wake_up();
   return true;
 } // buffer_segment()
 
-/**
- * Add a new linear movement to the buffer.
- * The target is cartesian. It's translated to
- * delta/scara if needed.
- *
- *  cart            - target position in mm or degrees
- *  fr_mm_s         - (target) speed of the move (mm/s)
- *  extruder        - target extruder
- *  millimeters     - the length of the movement, if known
- *  inv_duration    - the reciprocal if the duration of the movement, if known (kinematic only if feeedrate scaling is enabled)
- */
-bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, const uint8_t extruder/*=active_extruder*/, const float millimeters/*=0.0*/
-  OPTARG(SCARA_FEEDRATE_SCALING, const_float_t inv_duration/*=0.0*/)
-) {
-  xyze_pos_t machine = cart;
-  TERN_(HAS_POSITION_MODIFIERS, apply_modifiers(machine));
-
-  #if IS_KINEMATIC
+#if IS_KINEMATIC
 
+  /**
+   * Add a new linear movement to the buffer, with the
+   * kinematic target already worked out.
+   *
+   *  cart            - target position in mm or degrees
+   *  abce            - the same target in machine units, with E
+   *  fr_mm_s         - (target) speed of the move (mm/s)
+   *  extruder        - target extruder
+   *  millimeters     - the length of the movement, if known
+   *  inv_duration    - the reciprocal if the duration of the movement, if known (kinematic only if feeedrate scaling is enabled)
+   */
+  bool Planner::buffer_kinematic_segment(const xyze_pos_t &cart, const abce_pos_t &abce, const_feedRate_t fr_mm_s, const uint8_t extruder, const float millimeters
+    OPTARG(SCARA_FEEDRATE_SCALING, const_float_t inv_duration)
+  ) {
     #if HAS_JUNCTION_DEVIATION
       const xyze_pos_t cart_dist_mm = LOGICAL_AXIS_ARRAY(
         cart.e - position_cart.e,
@@ -3017,29 +3363,136 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, cons
 
     const float mm = millimeters ?: (cart_dist_mm.x || cart_dist_mm.y) ? cart_dist_mm.magnitude() : TERN0(HAS_Z_AXIS, ABS(cart_dist_mm.z));
 
-    // Cartesian XYZ to kinematic ABC, stored in global 'delta'
-    inverse_kinematics(machine);
-
     #if ENABLED(SCARA_FEEDRATE_SCALING)
       // For SCARA scale the feed rate from mm/s to degrees/s
       // i.e., Complete the angular vector in the given time.
       const float duration_recip = inv_duration ?: fr_mm_s / mm;
-      const xyz_pos_t diff = delta - position_float;
+      const xyz_pos_t diff = abce - position_float;
       const feedRate_t feedrate = diff.magnitude() * duration_recip;
     #else
       const feedRate_t feedrate = fr_mm_s;
     #endif
-    TERN_(HAS_EXTRUDERS, delta.e = machine.e);
-    if (buffer_segment(delta OPTARG(HAS_DIST_MM_ARG, cart_dist_mm), feedrate, extruder, mm)) {
+    if (buffer_segment(abce OPTARG(HAS_DIST_MM_ARG, cart_dist_mm), feedrate, extruder, mm)) {
       position_cart = cart;
       return true;
     }
     return false;
+  }
+
+#endif
+
+/**
+ * Add a new linear movement to the buffer.
+ * The target is cartesian. It's translated to
+ * delta/scara if needed.
+ *
+ *  cart            - target position in mm or degrees
+ *  fr_mm_s         - (target) speed of the move (mm/s)
+ *  extruder        - target extruder
+ *  millimeters     - the length of the movement, if known
+ *  inv_duration    - the reciprocal if the duration of the movement, if known (kinematic only if feeedrate scaling is enabled)
+ */
+bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, const uint8_t extruder/*=active_extruder*/, const float millimeters/*=0.0*/
+  OPTARG(SCARA_FEEDRATE_SCALING, const_float_t inv_duration/*=0.0*/)
+) {
+  xyze_pos_t machine = cart;
+  TERN_(HAS_POSITION_MODIFIERS, apply_modifiers(machine));
+
+  #if IS_KINEMATIC
+    // Cartesian XYZ to kinematic ABC, stored in global 'delta'
+    inverse_kinematics(machine);
+    TERN_(HAS_EXTRUDERS, delta.e = machine.e);
+    return buffer_kinematic_segment(cart, delta, fr_mm_s, extruder, millimeters OPTARG(SCARA_FEEDRATE_SCALING, inv_duration));
   #else
     return buffer_segment(machine, fr_mm_s, extruder, millimeters);
   #endif
 } // buffer_line()
 
+#ifdef KINEMATIC_SEGMENT_BATCH
+
+  /**
+   * Add a run of linear movements to the buffer, with the
+   * kinematics for all of them worked out as one batch.
+   *
+   *  cart            - target positions in mm or degrees
+   *  count           - number of targets, up to KINEMATIC_SEGMENT_BATCH
+   *  fr_mm_s         - (target) speed of the moves (mm/s)
+   *  extruder        - target extruder
+   *  millimeters     - the length of each movement, if known
+   *  inv_duration    - the reciprocal if the duration of each movement, if known (kinematic only if feeedrate scaling is enabled)
+   *
+   * Return the number of movements buffered, less than 'count' if one was dropped.
+   */
+  uint8_t Planner::buffer_segments(const xyze_pos_t cart[], const uint8_t count, const_feedRate_t fr_mm_s, const uint8_t extruder/*=active_extruder*/, const float millimeters/*=0.0*/
+    OPTARG(SCARA_FEEDRATE_SCALING, const_float_t inv_duration/*=0.0*/)
+  ) {
+    if (!count) return 0;
+    #if HAS_POSITION_MODIFIERS
+      xyze_pos_t machine[KINEMATIC_SEGMENT_BATCH];
+      LOOP_L_N(i, count) {
+        machine[i] = cart[i];
+        apply_modifiers(machine[i]);
+      }
+    #else
+      const xyze_pos_t * const machine = cart;
+    #endif
+    abce_pos_t abce[KINEMATIC_SEGMENT_BATCH];
+    inverse_kinematics(machine, abce, count);
+    LOOP_L_N(i, count)
+      if (!buffer_kinematic_segment(cart[i], abce[i], fr_mm_s, extruder, millimeters OPTARG(SCARA_FEEDRATE_SCALING, inv_duration)))
+        return i;
+    return count;
+  }
+
+#endif
+
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Add the next chords of an arc in the XY plane to the buffer, as a single block.
+   * Each chord ends on the whole step nearest to its end on the arc, so the steps
+   * never drift from the arc and the last chord ends on the block target.
+   *
+   *  cart     - the start of the first chord and the end of each chord, in mm
+   *  chords   - number of chords, up to ARC_BLOCK_CHORDS
+   *  fr_mm_s  - (target) speed of the move (mm/s)
+   *  extruder - target extruder
+   */
+  bool Planner::buffer_arc(const xyze_pos_t cart[], const uint8_t chords, const_feedRate_t fr_mm_s, const uint8_t extruder/*=active_extruder*/) {
+    arc_chords_t arc;
+    arc.steps.chords = chords;
+    arc.xy_mm = 0;
+
+    xy_long_t reached = { position.x, position.y };
+    LOOP_S_LE_N(i, 1, chords) {
+      // The chord in steps, from the end of the last one
+      const xy_long_t end = {
+        int32_t(LROUND(cart[i].x * settings.axis_steps_per_mm[X_AXIS])),
+        int32_t(LROUND(cart[i].y * settings.axis_steps_per_mm[Y_AXIS]))
+      };
+      const xy_long_t delta = end - reached;
+      if (!WITHIN(delta.x, -32767, 32767) || !WITHIN(delta.y, -32767, 32767)) return false;
+      arc.steps.chord[i - 1].set(delta.x, delta.y);
+      reached = end;
+
+      // The chord in mm, for the length and the junctions
+      const xy_pos_t chord = { cart[i].x - cart[i - 1].x, cart[i].y - cart[i - 1].y };
+      arc.xy_mm += HYPOT(chord.x, chord.y);
+      if (i == 1) arc.first = chord;
+      if (i == 2) arc.second = chord;
+      arc.last = chord;
+    }
+
+    const xyze_pos_t dist = cart[chords] - cart[0];
+    const float millimeters = SQRT(sq(arc.xy_mm) GANG_N(SUB2(LINEAR_AXES), + sq(dist.z), + sq(dist.i), + sq(dist.j), + sq(dist.k)));
+
+    xyze_pos_t machine = cart[chords];
+    TERN_(HAS_POSITION_MODIFIERS, apply_modifiers(machine));
+    return buffer_segment(machine, fr_mm_s, extruder, millimeters, &arc);
+  }
+
+#endif // ARC_BLOCKS
+
 #if ENABLED(DIRECT_STEPPING)
 
   void Planner::buffer_page(const page_idx_t page_idx, const uint8_t extruder, const uint16_t num_steps) {
@@ -3053,6 +3506,9 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, cons
 
     block->flag = BLOCK_FLAG_IS_PAGE;
 
+    // Pages aren't counted in the queued runtime, so the Stepper ISR mustn't count them out
+    TERN_(HAS_BLOCK_RUNTIME, block->segment_time_us = 0);
+
     #if HAS_FAN
       FANS_LOOP(i) block->fan_speed[i] = thermalManager.fan_speed[i];
     #endif
@@ -3091,7 +3547,7 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, cons
     }
 
     // Move buffer head
-    block_buffer_head = next_buffer_head;
+    release_index(block_buffer_head, next_buffer_head);
 
     stepper.enable_all_steppers();
     stepper.wake_up();
@@ -3267,21 +3723,32 @@ void Planner::set_max_feedrate(const uint8_t axis, float inMaxFeedrateMMS) {
 
 #endif
 
-#if HAS_WIRED_LCD
+#if HAS_BLOCK_RUNTIME
 
-  uint16_t Planner::block_buffer_runtime() {
+  /**
+   * Runtime of the blocks queued and not yet taken by the Stepper ISR.
+   * The main loop adds to one count and the ISR to the other, so
+   * the difference needs no critical section.
+   */
+  uint32_t Planner::queued_runtime_us() {
     #ifdef __AVR__
-      // Protect the access to the variable. Only required for AVR, as
-      //  any 32bit CPU offers atomic access to 32bit variables
-      const bool was_enabled = stepper.suspend();
+      // The ISR may update the count between the bytes of a read, so keep
+      // reading until 2 consecutive reads return the same value.
+      uint32_t taken, check = block_buffer_runtime_taken_us;
+      do {
+        taken = check;
+        BLOCK_FENCE();
+        check = block_buffer_runtime_taken_us;
+      } while (taken != check);
+    #else
+      // Any 32bit CPU offers atomic access to 32bit variables
+      const uint32_t taken = block_buffer_runtime_taken_us;
     #endif
+    return block_buffer_runtime_us - taken;
+  }
 
-    uint32_t bbru = block_buffer_runtime_us;
-
-    #ifdef __AVR__
-      // Reenable Stepper ISR
-      if (was_enabled) stepper.wake_up();
-    #endif
+  uint16_t Planner::block_buffer_runtime() {
+    uint32_t bbru = queued_runtime_us();
 
     // To translate µs to ms a division by 1000 would be required.
     // We introduce 2.4% error here by dividing by 1024.
@@ -3292,19 +3759,9 @@ void Planner::set_max_feedrate(const uint8_t axis, float inMaxFeedrateMMS) {
     return bbru;
   }
 
+  // Call with the Stepper ISR suspended
   void Planner::clear_block_buffer_runtime() {
-    #ifdef __AVR__
-      // Protect the access to the variable. Only required for AVR, as
-      //  any 32bit CPU offers atomic access to 32bit variables
-      const bool was_enabled = stepper.suspend();
-    #endif
-
-    block_buffer_runtime_us = 0;
-
-    #ifdef __AVR__
-      // Reenable Stepper ISR
-      if (was_enabled) stepper.wake_up();
-    #endif
+    block_buffer_runtime_us = block_buffer_runtime_taken_us = 0;
   }
 
 #endif
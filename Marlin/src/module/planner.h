@@ -75,6 +75,12 @@
   #define IS_PAGE(B) false
 #endif
 
+#if ENABLED(ARC_BLOCKS)
+  #define IS_ARC(B) TEST(B->flag, BLOCK_BIT_IS_ARC)
+#else
+  #define IS_ARC(B) false
+#endif
+
 #if ENABLED(EXTERNAL_CLOSED_LOOP_CONTROLLER)
   #include "../feature/closedloop.h"
 #endif
@@ -115,6 +121,11 @@ enum BlockFlagBit : char {
   #if ENABLED(LASER_SYNCHRONOUS_M106_M107)
     , BLOCK_BIT_SYNC_FANS
   #endif
+
+  // Arc in the XY plane
+  #if ENABLED(ARC_BLOCKS)
+    , BLOCK_BIT_IS_ARC
+  #endif
 };
 
 enum BlockFlag : char {
@@ -128,6 +139,9 @@ enum BlockFlag : char {
   #if ENABLED(LASER_SYNCHRONOUS_M106_M107)
     , BLOCK_FLAG_SYNC_FANS          = _BV(BLOCK_BIT_SYNC_FANS)
   #endif
+  #if ENABLED(ARC_BLOCKS)
+    , BLOCK_FLAG_IS_ARC             = _BV(BLOCK_BIT_IS_ARC)
+  #endif
 };
 
 #define BLOCK_MASK_SYNC ( BLOCK_FLAG_SYNC_POSITION | TERN0(LASER_SYNCHRONOUS_M106_M107, BLOCK_FLAG_SYNC_FANS) )
@@ -156,6 +170,29 @@ enum BlockFlag : char {
 
 #endif
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Part of an arc in the XY plane, as a series of chords stepped in turn by the
+   * Stepper ISR. The planner rounds the chords to whole steps, so the ISR only sets
+   * up the X and Y Bresenham terms at each chord. Every chord takes the same number
+   * of step events, so the step event rate follows the speed along the arc.
+   */
+  typedef struct {
+    xy_int_t chord[ARC_BLOCK_CHORDS];       // XY steps of each chord
+    uint32_t chord_events;                  // Step events for each chord
+    uint8_t chords;                         // Number of chords in the block
+  } block_arc_t;
+
+  // The chords of an arc block to plan, with their lengths and directions in mm
+  typedef struct {
+    block_arc_t steps;                      // Chords for the block
+    float xy_mm;                            // Length of the chords in XY
+    xy_float_t first, second, last;         // The first, second and last chords, for junction deviation
+  } arc_chords_t;
+
+#endif
+
 /**
  * struct block_t
  *
@@ -214,7 +251,7 @@ typedef struct block_t {
     uint16_t advance_speed,                 // STEP timer value for extruder speed offset ISR
              max_adv_steps,                 // max. advance steps to get cruising speed pressure (not always nominal_speed!)
              final_adv_steps;               // advance steps due to exit speed
-    float e_D_ratio;
+    uint32_t advance_factor;                // (Q24) Advance steps per step/s, for the exit rate
   #endif
 
   uint32_t nominal_rate,                    // The nominal step rate for this block in step_events/sec
@@ -222,10 +259,19 @@ typedef struct block_t {
            final_rate,                      // The minimal rate at exit
            acceleration_steps_per_s2;       // acceleration steps/sec^2
 
+  #if ENABLED(FIXED_POINT_TRAPEZOIDS)
+    uint32_t acceleration_inverse;          // 2^acceleration_shift / (2 * acceleration_steps_per_s2)
+    uint8_t acceleration_shift;
+  #endif
+
   #if ENABLED(DIRECT_STEPPING)
     page_idx_t page_idx;                    // Page index used for direct stepping
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    block_arc_t arc;                        // The chords to step, for an arc block
+  #endif
+
   #if HAS_CUTTER
     cutter_power_t cutter_power;            // Power level for Spindle, Laser, etc.
   #endif
@@ -238,7 +284,7 @@ typedef struct block_t {
     uint8_t valve_pressure, e_to_p_pressure;
   #endif
 
-  #if HAS_WIRED_LCD
+  #if HAS_BLOCK_RUNTIME
     uint32_t segment_time_us;
   #endif
 
@@ -252,11 +298,27 @@ typedef struct block_t {
 
 } block_t;
 
-#if ANY(LIN_ADVANCE, SCARA_FEEDRATE_SCALING, GRADIENT_MIX, LCD_SHOW_E_TOTAL)
+#if ANY(SCARA_FEEDRATE_SCALING, GRADIENT_MIX, LCD_SHOW_E_TOTAL)
   #define HAS_POSITION_FLOAT 1
 #endif
 
-#define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
+#if ENABLED(BUFFER_ARENA)
+  #define BLOCK_MOD(n) ((n)&Planner::block_buffer_mask)
+  #define BUFFER_ARENA_MAX_BLOCKS 64  // The most blocks M577 can give the planner
+#else
+  #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
+#endif
+
+/**
+ * Keep memory accesses on either side of this in order, for the handoff
+ * of blocks between the main loop and the Stepper ISR. AVR has one core,
+ * so the compiler is the only one that could reorder them.
+ */
+#ifdef __AVR__
+  #define BLOCK_FENCE() __asm__ __volatile__("" ::: "memory")
+#else
+  #define BLOCK_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
 
 #if ENABLED(LASER_POWER_INLINE)
   typedef struct {
@@ -317,7 +379,8 @@ typedef struct {
 } skew_factor_t;
 
 #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
-  typedef IF<(BLOCK_BUFFER_SIZE > 64), uint16_t, uint8_t>::type last_move_t;
+  // Counts down from twice the number of blocks, which M577 can raise with BUFFER_ARENA
+  typedef IF<(_MAX(BLOCK_BUFFER_SIZE, TERN0(BUFFER_ARENA, BUFFER_ARENA_MAX_BLOCKS)) > 64), uint16_t, uint8_t>::type last_move_t;
 #endif
 
 class Planner {
@@ -335,8 +398,31 @@ class Planner {
      *
      *  Writer of head is Planner::buffer_segment().
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
+     *
+     *  With BUFFER_ARENA the blocks live at the start of the shared arena
+     *  and the number of blocks (block_buffer_mask + 1) is set by M577.
+     */
+    #if ENABLED(BUFFER_ARENA)
+      static block_t *block_buffer;
+      static uint8_t block_buffer_mask;             // Number of blocks minus 1. Always a power of 2 minus 1.
+    #else
+      static block_t block_buffer[BLOCK_BUFFER_SIZE];
+    #endif
+    /**
+     * The block buffer is a single-producer, single-consumer queue. Each index
+     * has one writer, so neither side has to hold off the other to use it:
+     *
+     *  - block_buffer_head    : Main loop. Moved on to publish a filled block.
+     *  - block_buffer_nonbusy : Stepper ISR (or the step compiler). Moved on to take a block.
+     *  - block_buffer_tail    : Stepper ISR. Moved on to free a finished block.
+     *
+     * Blocks from tail up to nonbusy are busy. The main loop may still update a
+     * queued block after claim_block(), which makes the ISR pass it over, and
+     * hands it back with unclaim_block(). The writer of an index moves it with
+     * release_index() and the other side reads it with acquire_index().
+     *
+     * Only block_buffer_planned is written by both, each only moving it forward.
      */
-    static block_t block_buffer[BLOCK_BUFFER_SIZE];
     static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
                             block_buffer_nonbusy,   // Index of the first non busy block
                             block_buffer_planned,   // Index of the optimally planned block
@@ -457,6 +543,60 @@ class Planner {
      */
     static float previous_nominal_speed_sqr;
 
+    #if HAS_JUNCTION_DEVIATION
+      /**
+       * Unit vector of previous path line segment
+       */
+      static xyze_float_t prev_unit_vec;
+    #endif
+
+    #if HAS_CLASSIC_JERK
+      /**
+       * Exit speed limited by a jerk to full halt of previous path line segment
+       */
+      static float previous_safe_speed;
+    #endif
+
+    #if ENABLED(MERGE_COLLINEAR_MOVES)
+      /**
+       * The planner state from before the last queued move, to populate
+       * its block again when the next move continues it in a straight line
+       */
+      typedef struct {
+        uint8_t block_index;                // Block the state applies to
+        uint8_t extruder;
+        feedRate_t fr_mm_s;
+        float millimeters,                  // The length of the block, if known
+              deviation;                    // (mm) Sum of the distances of merged points from the block
+        xyze_long_t position;
+        #if HAS_POSITION_FLOAT
+          xyze_pos_t position_float;
+        #endif
+        xyze_float_t previous_speed;
+        float previous_nominal_speed_sqr;
+        #if HAS_JUNCTION_DEVIATION
+          xyze_float_t prev_unit_vec;
+        #endif
+        #if HAS_CLASSIC_JERK
+          float previous_safe_speed;
+        #endif
+        #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
+          last_move_t extruder_last_move[E_STEPPERS];
+        #endif
+        #if ENABLED(BACKLASH_COMPENSATION)
+          axis_bits_t backlash_direction_bits;
+          #ifdef BACKLASH_SMOOTHING_MM
+            xyz_long_t backlash_residual_error;
+          #endif
+        #endif
+        #if ENABLED(POWER_LOSS_RECOVERY)
+          uint32_t sdpos;                   // Resume from the first merged command
+        #endif
+      } merge_state_t;
+
+      static merge_state_t merge;
+    #endif
+
     /**
      * Limit where 64bit math is necessary for acceleration calculation
      */
@@ -471,8 +611,10 @@ class Planner {
       static last_move_t g_uc_extruder_last_move[E_STEPPERS];
     #endif
 
-    #if HAS_WIRED_LCD
-      volatile static uint32_t block_buffer_runtime_us; // Theoretical block buffer runtime in µs
+    #if HAS_BLOCK_RUNTIME
+      static uint32_t block_buffer_runtime_us;                // Theoretical runtime of the blocks queued, in µs
+      volatile static uint32_t block_buffer_runtime_taken_us; // Runtime of the blocks the Stepper ISR took, in µs
+      static uint32_t queued_runtime_us();
     #endif
 
   public:
@@ -683,20 +825,58 @@ class Planner {
       }
     #endif // HAS_POSITION_MODIFIERS
 
+    // Read an index the other side moves, before reading what it published
+    FORCE_INLINE static uint8_t acquire_index(const volatile uint8_t &index) {
+      const uint8_t i = index;
+      BLOCK_FENCE();
+      return i;
+    }
+
+    // Move an index the other side reads, after writing what it publishes
+    FORCE_INLINE static void release_index(volatile uint8_t &index, const uint8_t i) {
+      BLOCK_FENCE();
+      index = i;
+    }
+
     // Number of moves currently in the planner including the busy block, if any
-    FORCE_INLINE static uint8_t movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_tail); }
+    FORCE_INLINE static uint8_t movesplanned() { return BLOCK_MOD(acquire_index(block_buffer_head) - acquire_index(block_buffer_tail)); }
 
     // Number of nonbusy moves currently in the planner
-    FORCE_INLINE static uint8_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
+    FORCE_INLINE static uint8_t nonbusy_movesplanned() { return BLOCK_MOD(acquire_index(block_buffer_head) - acquire_index(block_buffer_nonbusy)); }
 
     // Remove all blocks from the buffer
     FORCE_INLINE static void clear_block_buffer() { block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail = 0; }
 
     // Check if movement queue is full
-    FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
+    FORCE_INLINE static bool is_full() { return acquire_index(block_buffer_tail) == next_block_index(block_buffer_head); }
+
+    // Check if the Stepper ISR has taken the block - Must not be called from ISR contexts
+    FORCE_INLINE static bool is_block_busy(const block_t * const block) {
+      // Read the tail first. If the ISR moves on in between, a freed block may seem busy, never the reverse.
+      const uint8_t tail = acquire_index(block_buffer_tail);
+      return BLOCK_MOD(uint8_t(block - block_buffer) - tail) < BLOCK_MOD(acquire_index(block_buffer_nonbusy) - tail);
+    }
+
+    /**
+     * Mark a queued block RECALCULATE so the Stepper ISR won't take it while it's
+     * updated. Returns false, with the block left as it was, if the ISR already has it.
+     */
+    FORCE_INLINE static bool claim_block(block_t * const block) {
+      SBI(block->flag, BLOCK_BIT_RECALCULATE);
+      BLOCK_FENCE();  // The ISR takes a block, then looks for the flag. Do the reverse.
+      if (!is_block_busy(block)) return true;
+      CBI(block->flag, BLOCK_BIT_RECALCULATE);
+      return false;
+    }
+
+    // Let the Stepper ISR take a block, with all the updates made to it
+    FORCE_INLINE static void unclaim_block(block_t * const block) {
+      BLOCK_FENCE();
+      CBI(block->flag, BLOCK_BIT_RECALCULATE);
+    }
 
     // Get count of movement slots free
-    FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
+    FORCE_INLINE static uint8_t moves_free() { return TERN(BUFFER_ARENA, block_buffer_mask, BLOCK_BUFFER_SIZE - 1) - movesplanned(); }
 
     /**
      * Planner::get_next_free_block
@@ -724,6 +904,7 @@ class Planner {
      *  fr_mm_s     - (target) speed of the move
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
+     *  arc         - the chords of an arc in XY, for an arc block
      *
      * Returns true if movement was buffered, false otherwise
      */
@@ -731,8 +912,23 @@ class Planner {
       OPTARG(HAS_POSITION_FLOAT, const xyze_pos_t &target_float)
       OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
       , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters=0.0
+      OPTARG(ARC_BLOCKS, const arc_chords_t * const arc=nullptr)
     );
 
+    #if ENABLED(MERGE_COLLINEAR_MOVES)
+      /**
+       * Planner::reopen_collinear_block
+       *
+       * Take the last queued block back to merge a move that continues it in a straight line.
+       *
+       *  target      - target position in steps units
+       *  millimeters - the length of the movement, if known. Updated for the merged block.
+       *
+       * Returns the block to populate again, or nullptr
+       */
+      static block_t* reopen_collinear_block(const xyze_long_t &target, const_feedRate_t fr_mm_s, const uint8_t extruder, float &millimeters, uint8_t &next_buffer_head);
+    #endif
+
     /**
      * Planner::_populate_block
      *
@@ -742,6 +938,7 @@ class Planner {
      *  fr_mm_s     - (target) speed of the move
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
+     *  arc         - the chords of an arc in XY, for an arc block
      *
      * Returns true is movement is acceptable, false otherwise
      */
@@ -749,6 +946,7 @@ class Planner {
       OPTARG(HAS_POSITION_FLOAT, const xyze_pos_t &target_float)
       OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
       , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters=0.0
+      OPTARG(ARC_BLOCKS, const arc_chords_t * const arc=nullptr)
     );
 
     /**
@@ -778,12 +976,26 @@ class Planner {
      *  fr_mm_s     - (target) speed of the move
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
+     *  arc         - the chords of an arc in XY, for an arc block
      */
     static bool buffer_segment(const abce_pos_t &abce
       OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
       , const_feedRate_t fr_mm_s, const uint8_t extruder=active_extruder, const_float_t millimeters=0.0
+      OPTARG(ARC_BLOCKS, const arc_chords_t * const arc=nullptr)
     );
 
+    #if IS_KINEMATIC
+      /**
+       * Planner::buffer_kinematic_segment
+       *
+       * Add a new linear movement to the buffer, given the
+       * cartesian target and the same target in axis units.
+       */
+      static bool buffer_kinematic_segment(const xyze_pos_t &cart, const abce_pos_t &abce, const_feedRate_t fr_mm_s, const uint8_t extruder, const float millimeters
+        OPTARG(SCARA_FEEDRATE_SCALING, const_float_t inv_duration)
+      );
+    #endif
+
   public:
 
     /**
@@ -801,6 +1013,41 @@ class Planner {
       OPTARG(SCARA_FEEDRATE_SCALING, const_float_t inv_duration=0.0)
     );
 
+    #ifdef KINEMATIC_SEGMENT_BATCH
+      /**
+       * Add a run of linear movements to the buffer, with the
+       * inverse kinematics worked out for all of them at once.
+       *
+       *  cart         - target positions in mm or degrees
+       *  count        - number of targets, up to KINEMATIC_SEGMENT_BATCH
+       *  fr_mm_s      - (target) speed of the moves (mm/s)
+       *  extruder     - target extruder
+       *  millimeters  - the length of each movement, if known
+       *  inv_duration - the reciprocal if the duration of each movement, if known (kinematic only if feeedrate scaling is enabled)
+       *
+       * Return the number of movements buffered.
+       */
+      static uint8_t buffer_segments(const xyze_pos_t cart[], const uint8_t count, const_feedRate_t fr_mm_s, const uint8_t extruder=active_extruder, const float millimeters=0.0
+        OPTARG(SCARA_FEEDRATE_SCALING, const_float_t inv_duration=0.0)
+      );
+    #endif
+
+    #if ENABLED(ARC_BLOCKS)
+      /**
+       * Add the next chords of an arc in the XY plane to the buffer, as a single block.
+       * The chord ends are cartesian, with no change to XY from leveling.
+       *
+       *  cart     - the end of each chord in mm, the last one being the block target
+       *  chords   - number of chords, up to ARC_BLOCK_CHORDS
+       *  fr_mm_s  - (target) speed of the move (mm/s)
+       *  extruder - target extruder
+       *
+       * Return 'false' if the chords weren't queued, either due to cleaning or because
+       * a chord has too many steps for the block. Queue them as lines instead.
+       */
+      static bool buffer_arc(const xyze_pos_t cart[], const uint8_t chords, const_feedRate_t fr_mm_s, const uint8_t extruder=active_extruder);
+    #endif
+
     #if ENABLED(DIRECT_STEPPING)
       static void buffer_page(const page_idx_t page_idx, const uint8_t extruder, const uint16_t num_steps);
     #endif
@@ -889,7 +1136,7 @@ class Planner {
     /**
      * Does the buffer have any blocks queued?
      */
-    FORCE_INLINE static bool has_blocks_queued() { return (block_buffer_head != block_buffer_tail); }
+    FORCE_INLINE static bool has_blocks_queued() { return (acquire_index(block_buffer_head) != acquire_index(block_buffer_tail)); }
 
     /**
      * Get the current block for processing
@@ -901,16 +1148,25 @@ class Planner {
      */
     static block_t* get_current_block();
 
+    #if ENABLED(STEP_COMPILER)
+      /**
+       * Get the next block for the step compiler
+       * and mark the block as busy.
+       * Return nullptr if no block is ready.
+       */
+      static block_t* get_compile_block();
+    #endif
+
     /**
      * "Release" the current block so its slot can be reused.
      * Called when the current block is no longer needed.
      */
     FORCE_INLINE static void release_current_block() {
       if (has_blocks_queued())
-        block_buffer_tail = next_block_index(block_buffer_tail);
+        release_index(block_buffer_tail, next_block_index(block_buffer_tail));
     }
 
-    #if HAS_WIRED_LCD
+    #if HAS_BLOCK_RUNTIME
       static uint16_t block_buffer_runtime();
       static void clear_block_buffer_runtime();
     #endif
@@ -934,6 +1190,11 @@ class Planner {
 
   private:
 
+    #if ENABLED(PLANNER_BENCHMARK)
+      // The LINUX HAL self-test checks the planner math directly
+      friend class PlannerBenchmark;
+    #endif
+
     #if ENABLED(AUTOTEMP)
       #if ENABLED(AUTOTEMP_PROPORTIONAL)
         static void _autotemp_update_from_hotend();
@@ -945,8 +1206,8 @@ class Planner {
     /**
      * Get the index of the next / previous block in the ring buffer
      */
-    static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
-    static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    FORCE_INLINE static uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
+    FORCE_INLINE static uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
 
     /**
      * Calculate the distance (not time) it takes to accelerate
@@ -970,6 +1231,67 @@ class Planner {
       return (accel * 2 * distance - sq(initial_rate) + sq(final_rate)) / (accel * 4);
     }
 
+    #if ENABLED(FIXED_POINT_TRAPEZOIDS)
+      /**
+       * Cache a reciprocal of 2 * acceleration with 24 significant bits,
+       * so the block's trapezoids need no division.
+       */
+      static void set_acceleration_inverse(block_t * const block) {
+        const uint32_t d = block->acceleration_steps_per_s2 * 2;
+        if (!d) return;
+        uint8_t shift = 24;
+        for (uint32_t v = d; v >>= 1;) shift++;
+        block->acceleration_shift = shift;
+        block->acceleration_inverse = uint32_t((1ULL << shift) / d);
+      }
+
+      /**
+       * Divide by twice the block acceleration using the cached reciprocal.
+       * The product is never above the exact quotient and, up to 2^24, at most
+       * a couple of counts below it, so correct it upward for an exact floor().
+       * Larger quotients are left within 2^-23 of the exact value.
+       * 'n' must be below 2^38, so step rates are limited to 2^19.
+       */
+      static uint64_t divide_by_2accel(const block_t * const block, const uint64_t n) {
+        const uint32_t d = block->acceleration_steps_per_s2 * 2;
+        uint64_t q = (n * block->acceleration_inverse) >> block->acceleration_shift;
+        if (q < _BV32(24)) while ((q + 1) * d <= n) q++;
+        return q;
+      }
+
+      /**
+       * Integer estimate_acceleration_distance() for the block, rounded up (or down for
+       * deceleration) to whole steps. Zero if the rate doesn't change. Anything longer
+       * than the block is returned as step_event_count + 1 so the sum can't overflow.
+       */
+      static uint32_t estimate_acceleration_steps(const block_t * const block, const uint32_t initial_rate, const uint32_t target_rate) {
+        if (!block->acceleration_steps_per_s2 || target_rate <= initial_rate) return 0;
+        const uint64_t steps = divide_by_2accel(block, sq(uint64_t(target_rate)) - sq(uint64_t(initial_rate)) + block->acceleration_steps_per_s2 * 2 - 1);
+        return _MIN(steps, uint64_t(block->step_event_count) + 1);
+      }
+      static uint32_t estimate_deceleration_steps(const block_t * const block, const uint32_t initial_rate, const uint32_t target_rate) {
+        if (!block->acceleration_steps_per_s2 || target_rate >= initial_rate) return 0;
+        const uint64_t steps = divide_by_2accel(block, sq(uint64_t(initial_rate)) - sq(uint64_t(target_rate)));
+        return _MIN(steps, uint64_t(block->step_event_count) + 1);
+      }
+
+      /**
+       * Integer intersection_distance() for the block, rounded up to whole steps
+       * and limited to the block. Equal to CEIL(S / 2 + m / 2d) with m = final² - initial²
+       * and d = 2 * accel, but the quotient of m / 2d is taken separately and its
+       * remainder r decides the rounding: for even S add 1 if r > 0, for odd S if r > d.
+       */
+      static uint32_t intersection_steps(const block_t * const block, const uint32_t initial_rate, const uint32_t final_rate) {
+        const uint32_t d = block->acceleration_steps_per_s2 * 2, steps = block->step_event_count;
+        if (!d) return 0;
+        const int64_t m = int64_t(sq(uint64_t(final_rate))) - int64_t(sq(uint64_t(initial_rate))),
+                      q = (m >= 0 ? int64_t(divide_by_2accel(block, m)) : -int64_t(divide_by_2accel(block, d - 1 - m))) >> 1, // floor(m / 2d)
+                      r = m - q * 2 * d,                                                                                   // 0 <= r < 2d
+                      a = q + (steps + 1) / 2 + ((steps & 1) ? r > d : r > 0);
+        return a < 0 ? 0 : _MIN(uint32_t(a), steps);
+      }
+    #endif
+
     /**
      * Calculate the maximum allowable speed squared at this point, in order
      * to reach 'target_velocity_sqr' using 'acceleration' within a given
@@ -988,6 +1310,33 @@ class Planner {
       }
     #endif
 
+    #if ENABLED(LIN_ADVANCE)
+      /**
+       * Advance steps for a step rate of the block. The block's advance_factor
+       * is K * (E steps / step events) in Q24, so this takes no float math.
+       */
+      static uint16_t advance_steps(const block_t * const block, const uint32_t rate) {
+        #ifdef __AVR__
+          return MultiU24X32toH16(rate, block->advance_factor);
+        #else
+          return uint16_t((uint64_t(rate) * block->advance_factor + _BV32(23)) >> 24);
+        #endif
+      }
+
+      /**
+       * The advance steps are K times the E step rate, which is the block step rate
+       * times esteps / step_event_count. Keep that factor in Q24 so the advance steps
+       * for any step rate of the block take one integer multiply. Advance steps at
+       * the block acceleration are made every advance_speed timer ticks.
+       */
+      static void set_advance_factor(block_t * const block, const_float_t k, const uint32_t esteps, const uint32_t accel) {
+        const float advance_factor = k * esteps / block->step_event_count;
+        block->advance_factor = LROUND(advance_factor * float(_BV32(24)));
+        block->max_adv_steps = advance_steps(block, block->nominal_rate);
+        block->advance_speed = (STEPPER_TIMER_RATE) / (advance_factor * accel);
+      }
+    #endif
+
     static void calculate_trapezoid_for_block(block_t * const block, const_float_t entry_factor, const_float_t exit_factor);
 
     static void reverse_pass_kernel(block_t * const current, const block_t * const next);
@@ -996,16 +1345,30 @@ class Planner {
     static void reverse_pass();
     static void forward_pass();
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const uint8_t planned_block_index);
 
     static void recalculate();
 
     #if HAS_JUNCTION_DEVIATION
 
+      #if ENABLED(JD_FAST_MATH)
+        // Approximate 1 / SQRT(x) from the float bits and one Newton step. Max. relative error 0.065%.
+        FORCE_INLINE static float fast_rsqrt(const_float_t x) {
+          union { float f; uint32_t i; } y = { x };
+          y.i = 0x5F1FFFF9UL - (y.i >> 1);
+          return y.f * 0.703952253f * (2.38924456f - x * sq(y.f));
+        }
+      #endif
+
       FORCE_INLINE static void normalize_junction_vector(xyze_float_t &vector) {
         float magnitude_sq = 0;
         LOOP_LOGICAL_AXES(idx) if (vector[idx]) magnitude_sq += sq(vector[idx]);
-        vector *= RSQRT(magnitude_sq);
+        #if ENABLED(JD_FAST_MATH)
+          const float r = fast_rsqrt(magnitude_sq);
+          vector *= r * (1.5f - 0.5f * magnitude_sq * sq(r)); // A second Newton step for full precision
+        #else
+          vector *= RSQRT(magnitude_sq);
+        #endif
       }
 
       FORCE_INLINE static float limit_value_by_axis_maximum(const_float_t max_value, xyze_float_t &unit_vec) {
@@ -1019,6 +1382,8 @@ class Planner {
         return limit_value;
       }
 
+      static float junction_speed_sqr(const xyze_float_t &prev_unit_vec, const xyze_float_t &unit_vec, const_float_t acceleration, const_float_t millimeters);
+
     #endif // !CLASSIC_JERK
 };
 
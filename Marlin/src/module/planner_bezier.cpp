@@ -38,13 +38,48 @@
 #include "../gcode/queue.h"
 
 // See the meaning in the documentation of cubic_b_spline().
-#define MIN_STEP 0.002f
-#define MAX_STEP 0.1f
-#define SIGMA 0.1f
+#ifdef BEZIER_FLATNESS
+  #define FLATNESS_MM ((BEZIER_FLATNESS) * 0.001f)
+#else
+  #define MIN_STEP 0.002f
+  #define MAX_STEP 0.1f
+  #define SIGMA 0.1f
+#endif
 
 // Compute the linear interpolation between two real numbers.
 static inline float interp(const_float_t a, const_float_t b, const_float_t t) { return (1 - t) * a + t * b; }
 
+#ifdef BEZIER_FLATNESS
+
+/**
+ * Evaluate a cubic in power form, a + t(b + t(c + t d)), with Horner's rule.
+ * Three multiply-adds per axis, against the six interpolations of De Casteljau.
+ */
+static inline float eval_power(const_float_t a, const_float_t b, const_float_t c, const_float_t d, const_float_t t) {
+  return a + t * (b + t * (c + t * d));
+}
+
+/**
+ * Get the furthest t after t0 that keeps the chord within FLATNESS_MM of the curve.
+ *
+ * A span of the curve [t0, t0+h] strays from its chord by at most h²/8 times the largest |B''| on
+ * the span. B'' is linear in t, so that's the larger of |B''| at the two ends. Take h from |B''(t0)|,
+ * then shrink it if |B''(t0+h)| is larger. Any shorter step is then also within the bound.
+ */
+static float next_flat_t(const xy_pos_t &dd0, const xy_pos_t &dd1, const_float_t t0) {
+  const float limit = 8 * (FLATNESS_MM), rest = 1 - t0;
+  float h = rest, m = (dd0 + dd1 * t0).magnitude();
+  if (m > limit) NOMORE(h, SQRT(limit / m));
+  m = (dd0 + dd1 * (t0 + h)).magnitude();
+  if (m > limit) NOMORE(h, SQRT(limit / m));
+  if (h >= rest) return 1;
+  // Split a short remainder into two even steps rather than leave a sliver at the end
+  if (2 * h > rest) h = rest * 0.5f;
+  return t0 + h;
+}
+
+#else
+
 /**
  * Compute a Bézier curve using the De Casteljau's algorithm (see
  * https://en.wikipedia.org/wiki/De_Casteljau%27s_algorithm), which is
@@ -66,6 +101,8 @@ static inline float eval_bezier(const_float_t a, const_float_t b, const_float_t
  */
 static inline float dist1(const_float_t x1, const_float_t y1, const_float_t x2, const_float_t y2) { return ABS(x1 - x2) + ABS(y1 - y2); }
 
+#endif
+
 /**
  * The algorithm for computing the step is loosely based on the one in Kig
  * (See https://sources.debian.net/src/kig/4:15.08.3-1/misc/kigpainter.cpp/#L759)
@@ -104,6 +141,11 @@ static inline float dist1(const_float_t x1, const_float_t y1, const_float_t x2,
  * estimates; however, given the improbability of such configurations,
  * the mitigation offered by MIN_STEP and the small computational
  * power available on Arduino, I think it is not wise to implement it.
+ *
+ * With BEZIER_FLATNESS the step comes from next_flat_t() instead, which
+ * bounds the distance between each chord and the curve, so the search
+ * and its constants aren't needed. Straight or short curves then take
+ * just one or two segments instead of ten or more.
  */
 void cubic_b_spline(
   const xyze_pos_t &position,       // current position
@@ -117,7 +159,16 @@ void cubic_b_spline(
 
   xyze_pos_t bez_target;
   bez_target.set(position.x, position.y);
-  float step = MAX_STEP;
+
+  #ifdef BEZIER_FLATNESS
+    // Power form coefficients, and B''(t) = dd0 + dd1 * t
+    const xy_pos_t c1 = (first - position) * 3,
+                   c2 = (position - first * 2 + second) * 3,
+                   c3 = target - position + (first - second) * 3,
+                   dd0 = c2 * 2, dd1 = c3 * 6;
+  #else
+    float step = MAX_STEP;
+  #endif
 
   millis_t next_idle_ms = millis() + 200UL;
 
@@ -130,54 +181,72 @@ void cubic_b_spline(
       idle();
     }
 
-    // First try to reduce the step in order to make it sufficiently
-    // close to a linear interpolation.
-    bool did_reduce = false;
-    float new_t = t + step;
-    NOMORE(new_t, 1);
-    float new_pos0 = eval_bezier(position.x, first.x, second.x, target.x, new_t),
-          new_pos1 = eval_bezier(position.y, first.y, second.y, target.y, new_t);
-    for (;;) {
-      if (new_t - t < (MIN_STEP)) break;
-      const float candidate_t = 0.5f * (t + new_t),
-                  candidate_pos0 = eval_bezier(position.x, first.x, second.x, target.x, candidate_t),
-                  candidate_pos1 = eval_bezier(position.y, first.y, second.y, target.y, candidate_t),
-                  interp_pos0 = 0.5f * (bez_target.x + new_pos0),
-                  interp_pos1 = 0.5f * (bez_target.y + new_pos1);
-      if (dist1(candidate_pos0, candidate_pos1, interp_pos0, interp_pos1) <= (SIGMA)) break;
-      new_t = candidate_t;
-      new_pos0 = candidate_pos0;
-      new_pos1 = candidate_pos1;
-      did_reduce = true;
-    }
+    #ifdef BEZIER_FLATNESS
 
-    // If we did not reduce the step, maybe we should enlarge it.
-    if (!did_reduce) for (;;) {
-      if (new_t - t > MAX_STEP) break;
-      const float candidate_t = t + 2 * (new_t - t);
-      if (candidate_t >= 1) break;
-      const float candidate_pos0 = eval_bezier(position.x, first.x, second.x, target.x, candidate_t),
-                  candidate_pos1 = eval_bezier(position.y, first.y, second.y, target.y, candidate_t),
-                  interp_pos0 = 0.5f * (bez_target.x + candidate_pos0),
-                  interp_pos1 = 0.5f * (bez_target.y + candidate_pos1);
-      if (dist1(new_pos0, new_pos1, interp_pos0, interp_pos1) > (SIGMA)) break;
-      new_t = candidate_t;
-      new_pos0 = candidate_pos0;
-      new_pos1 = candidate_pos1;
-    }
+      const float new_t = next_flat_t(dd0, dd1, t);
+      float new_pos0, new_pos1;
+      if (new_t < 1) {
+        new_pos0 = eval_power(position.x, c1.x, c2.x, c3.x, new_t);
+        new_pos1 = eval_power(position.y, c1.y, c2.y, c3.y, new_t);
+      }
+      else {
+        new_pos0 = target.x;
+        new_pos1 = target.y;
+      }
+
+    #else
 
-    // Check some postcondition; they are disabled in the actual
-    // Marlin build, but if you test the same code on a computer you
-    // may want to check they are respect.
-    /*
-      assert(new_t <= 1.0);
-      if (new_t < 1.0) {
-        assert(new_t - t >= (MIN_STEP) / 2.0);
-        assert(new_t - t <= (MAX_STEP) * 2.0);
+      // First try to reduce the step in order to make it sufficiently
+      // close to a linear interpolation.
+      bool did_reduce = false;
+      float new_t = t + step;
+      NOMORE(new_t, 1);
+      float new_pos0 = eval_bezier(position.x, first.x, second.x, target.x, new_t),
+            new_pos1 = eval_bezier(position.y, first.y, second.y, target.y, new_t);
+      for (;;) {
+        if (new_t - t < (MIN_STEP)) break;
+        const float candidate_t = 0.5f * (t + new_t),
+                    candidate_pos0 = eval_bezier(position.x, first.x, second.x, target.x, candidate_t),
+                    candidate_pos1 = eval_bezier(position.y, first.y, second.y, target.y, candidate_t),
+                    interp_pos0 = 0.5f * (bez_target.x + new_pos0),
+                    interp_pos1 = 0.5f * (bez_target.y + new_pos1);
+        if (dist1(candidate_pos0, candidate_pos1, interp_pos0, interp_pos1) <= (SIGMA)) break;
+        new_t = candidate_t;
+        new_pos0 = candidate_pos0;
+        new_pos1 = candidate_pos1;
+        did_reduce = true;
       }
-    */
 
-    step = new_t - t;
+      // If we did not reduce the step, maybe we should enlarge it.
+      if (!did_reduce) for (;;) {
+        if (new_t - t > MAX_STEP) break;
+        const float candidate_t = t + 2 * (new_t - t);
+        if (candidate_t >= 1) break;
+        const float candidate_pos0 = eval_bezier(position.x, first.x, second.x, target.x, candidate_t),
+                    candidate_pos1 = eval_bezier(position.y, first.y, second.y, target.y, candidate_t),
+                    interp_pos0 = 0.5f * (bez_target.x + candidate_pos0),
+                    interp_pos1 = 0.5f * (bez_target.y + candidate_pos1);
+        if (dist1(new_pos0, new_pos1, interp_pos0, interp_pos1) > (SIGMA)) break;
+        new_t = candidate_t;
+        new_pos0 = candidate_pos0;
+        new_pos1 = candidate_pos1;
+      }
+
+      // Check some postcondition; they are disabled in the actual
+      // Marlin build, but if you test the same code on a computer you
+      // may want to check they are respect.
+      /*
+        assert(new_t <= 1.0);
+        if (new_t < 1.0) {
+          assert(new_t - t >= (MIN_STEP) / 2.0);
+          assert(new_t - t <= (MAX_STEP) * 2.0);
+        }
+      */
+
+      step = new_t - t;
+
+    #endif
+
     t = new_t;
 
     // Compute and send new position
@@ -200,7 +269,7 @@ void cubic_b_spline(
       const xyze_pos_t &pos = bez_target;
     #endif
 
-    if (!planner.buffer_line(pos, scaled_fr_mm_s, active_extruder, step))
+    if (!planner.buffer_line(pos, scaled_fr_mm_s, active_extruder))
       break;
   }
 }
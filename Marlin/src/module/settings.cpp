@@ -36,7 +36,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V86"
+#define EEPROM_VERSION "V87"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -423,6 +423,16 @@ typedef struct SettingsDataStruct {
   //
   float planner_extruder_advance_K[_MAX(EXTRUDERS, 1)]; // M900 K  planner.extruder_advance_K
 
+  //
+  // INPUT_SHAPING_X / INPUT_SHAPING_Y
+  //
+  #if ENABLED(INPUT_SHAPING_X)
+    shaping_settings_t shaping_x;                       // M593 X F D T
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    shaping_settings_t shaping_y;                       // M593 Y F D T
+  #endif
+
   //
   // HAS_MOTOR_CURRENT_PWM
   //
@@ -1341,6 +1351,18 @@ void MarlinSettings::postprocess() {
       #endif
     }
 
+    //
+    // Input Shaping
+    //
+    #if ENABLED(INPUT_SHAPING_X)
+      _FIELD_TEST(shaping_x);
+      EEPROM_WRITE(stepper.shaper_x.settings);
+    #endif
+    #if ENABLED(INPUT_SHAPING_Y)
+      _FIELD_TEST(shaping_y);
+      EEPROM_WRITE(stepper.shaper_y.settings);
+    #endif
+
     //
     // Motor Current PWM
     //
@@ -2257,6 +2279,26 @@ void MarlinSettings::postprocess() {
         #endif
       }
 
+      //
+      // Input Shaping
+      //
+      #if ENABLED(INPUT_SHAPING_X)
+      {
+        shaping_settings_t shaping_x;
+        _FIELD_TEST(shaping_x);
+        EEPROM_READ(shaping_x);
+        if (!validating) stepper.set_shaping(stepper.shaper_x, shaping_x);
+      }
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+      {
+        shaping_settings_t shaping_y;
+        _FIELD_TEST(shaping_y);
+        EEPROM_READ(shaping_y);
+        if (!validating) stepper.set_shaping(stepper.shaper_y, shaping_y);
+      }
+      #endif
+
       //
       // Motor Current PWM
       //
@@ -3081,6 +3123,17 @@ void MarlinSettings::reset() {
     }
   #endif
 
+  //
+  // Input Shaping
+  //
+
+  #if ENABLED(INPUT_SHAPING_X)
+    stepper.set_shaping(stepper.shaper_x, { ShapingType::SHAPING_TYPE_X, SHAPING_FREQ_X, SHAPING_ZETA_X });
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    stepper.set_shaping(stepper.shaper_y, { ShapingType::SHAPING_TYPE_Y, SHAPING_FREQ_Y, SHAPING_ZETA_Y });
+  #endif
+
   //
   // Motor Current PWM
   //
@@ -3390,6 +3443,11 @@ void MarlinSettings::reset() {
     //
     TERN_(LIN_ADVANCE, gcode.M900_report(forReplay));
 
+    //
+    // Input Shaping
+    //
+    TERN_(HAS_SHAPING, gcode.M593_report(forReplay));
+
     //
     // Motor Current (SPI or PWM)
     //
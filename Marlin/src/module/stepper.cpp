@@ -96,6 +96,7 @@ Stepper stepper; // Singleton
 #include "../sd/cardreader.h"
 #include "../MarlinCore.h"
 #include "../HAL/shared/Delay.h"
+#include "../feature/isr_profiler.h"
 
 #if ENABLED(INTEGRATED_BABYSTEPPING)
   #include "../feature/babystep.h"
@@ -211,13 +212,20 @@ uint32_t Stepper::advance_divisor = 0,
 #endif
 
 #if ENABLED(S_CURVE_ACCELERATION)
-  int32_t __attribute__((used)) Stepper::bezier_A __asm__("bezier_A");    // A coefficient in Bézier speed curve with alias for assembler
-  int32_t __attribute__((used)) Stepper::bezier_B __asm__("bezier_B");    // B coefficient in Bézier speed curve with alias for assembler
-  int32_t __attribute__((used)) Stepper::bezier_C __asm__("bezier_C");    // C coefficient in Bézier speed curve with alias for assembler
-  uint32_t __attribute__((used)) Stepper::bezier_F __asm__("bezier_F");   // F coefficient in Bézier speed curve with alias for assembler
-  uint32_t __attribute__((used)) Stepper::bezier_AV __asm__("bezier_AV"); // AV coefficient in Bézier speed curve with alias for assembler
-  #ifdef __AVR__
-    bool __attribute__((used)) Stepper::A_negative __asm__("A_negative"); // If A coefficient was negative
+  #if ENABLED(S_CURVE_TABLE)
+    uint32_t Stepper::bezier_F,       // Speed at the start of the curve
+             Stepper::bezier_dV,      // Speed change across the curve
+             Stepper::bezier_AV;      // Inverse of the curve duration
+    bool Stepper::bezier_slowing;     // If the speed drops across the curve
+  #else
+    int32_t __attribute__((used)) Stepper::bezier_A __asm__("bezier_A");    // A coefficient in Bézier speed curve with alias for assembler
+    int32_t __attribute__((used)) Stepper::bezier_B __asm__("bezier_B");    // B coefficient in Bézier speed curve with alias for assembler
+    int32_t __attribute__((used)) Stepper::bezier_C __asm__("bezier_C");    // C coefficient in Bézier speed curve with alias for assembler
+    uint32_t __attribute__((used)) Stepper::bezier_F __asm__("bezier_F");   // F coefficient in Bézier speed curve with alias for assembler
+    uint32_t __attribute__((used)) Stepper::bezier_AV __asm__("bezier_AV"); // AV coefficient in Bézier speed curve with alias for assembler
+    #ifdef __AVR__
+      bool __attribute__((used)) Stepper::A_negative __asm__("A_negative"); // If A coefficient was negative
+    #endif
   #endif
   bool Stepper::bezier_2nd_half;    // =false If Bézier curve has been initialized or not
 #endif
@@ -240,10 +248,39 @@ uint32_t Stepper::advance_divisor = 0,
   uint32_t Stepper::nextBabystepISR = BABYSTEP_NEVER;
 #endif
 
+#if HAS_SHAPING
+  uint32_t Stepper::nextShapingISR = SHAPING_NEVER,
+           Stepper::shaping_time; // = 0
+  #if ENABLED(INPUT_SHAPING_X)
+    AxisShaper Stepper::shaper_x;
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    AxisShaper Stepper::shaper_y;
+  #endif
+#endif
+
 #if ENABLED(DIRECT_STEPPING)
   page_step_state_t Stepper::page_step_state;
 #endif
 
+#if ENABLED(ARC_BLOCKS)
+  uint32_t Stepper::advance_divisor_xy = 0,
+           Stepper::arc_events_left;
+  uint8_t Stepper::arc_chord;
+#endif
+
+#if ENABLED(STEP_COMPILER)
+  step_event_t Stepper::step_events[STEP_EVENT_BUFFER_SIZE];
+  volatile uint8_t Stepper::step_events_head, Stepper::step_events_tail; // = 0
+  volatile bool Stepper::step_events_resync; // = false
+  hal_timer_t Stepper::step_event_ticks;
+  volatile bool Stepper::compiling; // = false
+  block_t* Stepper::compile_block; // = nullptr
+  uint32_t Stepper::compiled_events;
+  uint8_t Stepper::compile_loops;
+  hal_timer_t Stepper::compile_ticks;
+#endif
+
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(S_CURVE_ACCELERATION)
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
@@ -587,8 +624,11 @@ void Stepper::set_directions() {
       count_direction[_AXIS(A)] = 1;            \
     }
 
-  TERN_(HAS_X_DIR, SET_STEP_DIR(X)); // A
-  TERN_(HAS_Y_DIR, SET_STEP_DIR(Y)); // B
+  // Shaped axes only count here. The shaping phase owns their DIR pins.
+  #define SET_COUNT_DIR(A) count_direction[_AXIS(A)] = motor_direction(_AXIS(A)) ? -1 : 1
+
+  TERN_(HAS_X_DIR, TERN(INPUT_SHAPING_X, SET_COUNT_DIR(X), SET_STEP_DIR(X))); // A
+  TERN_(HAS_Y_DIR, TERN(INPUT_SHAPING_Y, SET_COUNT_DIR(Y), SET_STEP_DIR(Y))); // B
   TERN_(HAS_Z_DIR, SET_STEP_DIR(Z)); // C
   TERN_(HAS_I_DIR, SET_STEP_DIR(I));
   TERN_(HAS_J_DIR, SET_STEP_DIR(J));
@@ -875,9 +915,67 @@ void Stepper::set_directions() {
    *      }
    *    These functions are translated to assembler for optimal performance.
    *    Coefficient calculation takes 70 cycles. Bezier point evaluation takes 150 cycles.
+   *
+   *  With S_CURVE_TABLE:
+   *
+   *    The curve only depends on VI and VF through its height, so it can be written as
+   *
+   *      V_f(t) = VI + (VF - VI) * S(t),  S(t) = 6t^5 - 15t^4 + 10t^3
+   *
+   *    S(t) is stored at 65 points over 0 <= t <= 1 and interpolated linearly between them.
+   *    The error of S is under 0.00025, so the speed stays within 0.025% of (VF - VI) of the curve.
+   *    The coefficients are just VI, |VF - VI| and its sign, and each point costs one multiply
+   *    for t, a table interpolation and one multiply to scale S(t).
    */
 
-  #ifdef __AVR__
+  #if ENABLED(S_CURVE_TABLE)
+
+    // S(t) at t = i / 64, scaled to 16 bits
+    constexpr uint16_t s_curve_point(const uint64_t i) {
+      return (i * i * i * (6 * i * i + 10 * 64 * 64 - 15 * 64 * i) * 0xFFFF + _BV32(29)) >> 30;
+    }
+
+    #define _SCURVE4(I)  s_curve_point(I), s_curve_point((I) + 1), s_curve_point((I) + 2), s_curve_point((I) + 3)
+    #define _SCURVE16(I) _SCURVE4(I), _SCURVE4((I) + 4), _SCURVE4((I) + 8), _SCURVE4((I) + 12)
+
+    static const uint16_t s_curve_table[65] PROGMEM = {
+      _SCURVE16(0), _SCURVE16(16), _SCURVE16(32), _SCURVE16(48), s_curve_point(64)
+    };
+
+    #undef _SCURVE4
+    #undef _SCURVE16
+
+    FORCE_INLINE void Stepper::_calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av) {
+      bezier_F = v0;
+      bezier_slowing = v1 < v0;
+      bezier_dV = bezier_slowing ? v0 - v1 : v1 - v0;
+      bezier_AV = av;
+    }
+
+    FORCE_INLINE int32_t Stepper::_eval_bezier_curve(const uint32_t curr_step) {
+      // t as unsigned Q0.16. AV is 2^24/time on AVR and 2^32/time otherwise.
+      #ifdef __AVR__
+        const uint16_t t = (bezier_AV * curr_step) >> 8;
+      #else
+        const uint16_t t = (bezier_AV * curr_step) >> 16;
+      #endif
+
+      // Interpolate S(t) between the table points
+      const uint8_t i = t >> 10, frac = uint8_t(t >> 2);
+      const uint16_t s0 = pgm_read_word(&s_curve_table[i]),
+                     ds = pgm_read_word(&s_curve_table[i + 1]) - s0;
+      #ifdef __AVR__
+        const uint16_t st = s0 + MultiU16X8toH16(frac, ds);
+      #else
+        const uint16_t st = s0 + ((uint32_t(ds) * frac + 128) >> 8);
+      #endif
+
+      // Scale the speed change by S(t). Split dV so both products fit in 32 bits.
+      const uint32_t dv = (uint32_t(uint16_t(bezier_dV >> 8)) * st + ((uint32_t(uint8_t(bezier_dV)) * st) >> 8)) >> 8;
+      return bezier_slowing ? bezier_F - dv : bezier_F + dv;
+    }
+
+  #elif defined(__AVR__)
 
     // For AVR we use assembly to maximize speed
     void Stepper::_calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av) {
@@ -1477,6 +1575,11 @@ void Stepper::isr() {
     DISABLE_ISRS();
   #endif
 
+  #if ENABLED(ISR_PROFILER)
+    isr_profiler.stepper_timer_restarted();
+    const uint32_t isr_start = isr_profiler.now();
+  #endif
+
   // Program timer compare for the maximum period, so it does NOT
   // flag an interrupt while this ISR is running - So changes from small
   // periods to big periods are respected and the timer does not reset to 0
@@ -1494,20 +1597,24 @@ void Stepper::isr() {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
-    if (!nextMainISR) pulse_phase_isr();                            // 0 = Do coordinated axes Stepper pulses
+    if (!nextMainISR) ISR_PROFILE(ISR_PULSE, pulse_phase_isr());    // 0 = Do coordinated axes Stepper pulses
 
     #if ENABLED(LIN_ADVANCE)
-      if (!nextAdvanceISR) nextAdvanceISR = advance_isr();          // 0 = Do Linear Advance E Stepper pulses
+      if (!nextAdvanceISR) ISR_PROFILE(ISR_ADVANCE, nextAdvanceISR = advance_isr()); // 0 = Do Linear Advance E Stepper pulses
+    #endif
+
+    #if HAS_SHAPING
+      if (!nextShapingISR) ISR_PROFILE(ISR_SHAPING, nextShapingISR = shaping_isr()); // 0 = Do Input Shaping XY pulses
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       const bool is_babystep = (nextBabystepISR == 0);              // 0 = Do Babystepping (XY)Z pulses
-      if (is_babystep) nextBabystepISR = babystepping_isr();
+      if (is_babystep) ISR_PROFILE(ISR_BABYSTEP, nextBabystepISR = babystepping_isr());
     #endif
 
     // ^== Time critical. NOTHING besides pulse generation should be above here!!!
 
-    if (!nextMainISR) nextMainISR = block_phase_isr();  // Manage acc/deceleration, get next block
+    if (!nextMainISR) ISR_PROFILE(ISR_BLOCK, nextMainISR = block_phase_isr()); // Manage acc/deceleration, get next block
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       if (is_babystep)                                  // Avoid ANY stepping too soon after baby-stepping
@@ -1522,6 +1629,7 @@ void Stepper::isr() {
       uint32_t(HAL_TIMER_TYPE_MAX),                     // Come back in a very long time
       nextMainISR                                       // Time until the next Pulse / Block phase
       OPTARG(LIN_ADVANCE, nextAdvanceISR)               // Come back early for Linear Advance?
+      OPTARG(HAS_SHAPING, nextShapingISR)               // Come back early for Input Shaping?
       OPTARG(INTEGRATED_BABYSTEPPING, nextBabystepISR)  // Come back early for Babystepping?
     );
 
@@ -1538,6 +1646,11 @@ void Stepper::isr() {
       if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
     #endif
 
+    #if HAS_SHAPING
+      if (nextShapingISR != SHAPING_NEVER) nextShapingISR -= interval;
+      shaping_time += interval;
+    #endif
+
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       if (nextBabystepISR != BABYSTEP_NEVER) nextBabystepISR -= interval;
     #endif
@@ -1610,6 +1723,11 @@ void Stepper::isr() {
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(MF_TIMER_STEP, hal_timer_t(next_isr_ticks));
 
+  #if ENABLED(ISR_PROFILER)
+    isr_profiler.stepper_timer_period(next_isr_ticks);
+    isr_profiler.add_interrupt(ISR_STEPPER, isr_profiler.now() - isr_start);
+  #endif
+
   // Don't forget to finally reenable interrupts
   ENABLE_ISRS();
 }
@@ -1634,6 +1752,10 @@ void Stepper::pulse_phase_isr() {
   if (abort_current_block) {
     abort_current_block = false;
     if (current_block) discard_current_block();
+    // Have the compiler drop the rest of its events
+    TERN_(STEP_COMPILER, step_events_resync = true);
+    // Don't let the shaped axes finish the move either
+    TERN_(HAS_SHAPING, flush_shaping());
   }
 
   // If there is no current block, do nothing
@@ -1642,10 +1764,33 @@ void Stepper::pulse_phase_isr() {
   // Skipping step processing causes motion to freeze
   if (TERN0(HAS_FREEZE_PIN, frozen)) return;
 
+  #if ENABLED(STEP_COMPILER)
+    // If the compiler fell behind, compile the steps here, as they would be
+    // without it. If the compiler was interrupted mid-group, check back soon.
+    if (step_events_tail == step_events_head) compile_steps(1);
+    if (step_events_tail == step_events_head) {
+      step_event_ticks = STEP_EVENT_RETRY_TICKS;
+      return;
+    }
+    // The first event of the group times the next group
+    const step_event_t &event = step_events[step_events_tail];
+    step_event_ticks = event.ticks;
+  #endif
+
   // Count of pending loops and events for this iteration
   const uint32_t pending_events = step_event_count - step_events_completed;
   uint8_t events_to_do = _MIN(pending_events, steps_per_isr);
 
+  TERN_(STEP_COMPILER, steps_per_isr = event.loops);
+
+  #if ENABLED(ARC_BLOCKS)
+    // Stop at the end of a chord, for the block phase to set up the next one
+    if (IS_ARC(current_block)) {
+      NOMORE(events_to_do, arc_events_left);
+      arc_events_left -= events_to_do;
+    }
+  #endif
+
   // Just update the value we will get at the end of the loop
   step_events_completed += events_to_do;
 
@@ -1661,12 +1806,40 @@ void Stepper::pulse_phase_isr() {
     #define _INVERT_STEP_PIN(AXIS) INVERT_## AXIS ##_STEP_PIN
 
     // Determine if a pulse is needed using Bresenham
-    #define PULSE_PREP(AXIS) do{ \
+    #define PULSE_PREP_DIV(AXIS, DIVISOR) do{ \
       delta_error[_AXIS(AXIS)] += advance_dividend[_AXIS(AXIS)]; \
       step_needed[_AXIS(AXIS)] = (delta_error[_AXIS(AXIS)] >= 0); \
       if (step_needed[_AXIS(AXIS)]) { \
+        count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
+        delta_error[_AXIS(AXIS)] -= DIVISOR; \
+      } \
+    }while(0)
+    #if ENABLED(STEP_COMPILER)
+      // Take the steps the compiler traced
+      #define PULSE_PREP(AXIS) do{ \
+        step_needed[_AXIS(AXIS)] = TEST(event_bits, _AXIS(AXIS)); \
+        if (step_needed[_AXIS(AXIS)]) \
+          count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
+      }while(0)
+    #else
+      #define PULSE_PREP(AXIS) PULSE_PREP_DIV(AXIS, advance_divisor)
+    #endif
+
+    // X and Y step over the current chord of an arc block
+    #if ENABLED(ARC_BLOCKS)
+      #define XY_PULSE_PREP(AXIS) PULSE_PREP_DIV(AXIS, advance_divisor_xy)
+    #else
+      #define XY_PULSE_PREP PULSE_PREP
+    #endif
+
+    // Queue the step for the shaping phase instead of pulsing now
+    #define SHAPED_PULSE_PREP(AXIS, SHAPER) do{ \
+      delta_error[_AXIS(AXIS)] += advance_dividend[_AXIS(AXIS)]; \
+      if (delta_error[_AXIS(AXIS)] >= 0) { \
         count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
         delta_error[_AXIS(AXIS)] -= advance_divisor; \
+        SHAPER.push(shaping_time, count_direction[_AXIS(AXIS)] < 0); \
+        nextShapingISR = 0; \
       } \
     }while(0)
 
@@ -1794,12 +1967,22 @@ void Stepper::pulse_phase_isr() {
     #endif // DIRECT_STEPPING
 
     if (!is_page) {
+      #if ENABLED(STEP_COMPILER)
+        // The motors to step for this event
+        const uint8_t event_bits = step_events[step_events_tail].bits;
+        step_events_tail = STEP_EVENT_NEXT(step_events_tail);
+      #endif
+
       // Determine if pulses are needed
-      #if HAS_X_STEP
-        PULSE_PREP(X);
+      #if ENABLED(INPUT_SHAPING_X)
+        SHAPED_PULSE_PREP(X, shaper_x);
+      #elif HAS_X_STEP
+        XY_PULSE_PREP(X);
       #endif
-      #if HAS_Y_STEP
-        PULSE_PREP(Y);
+      #if ENABLED(INPUT_SHAPING_Y)
+        SHAPED_PULSE_PREP(Y, shaper_y);
+      #elif HAS_Y_STEP
+        XY_PULSE_PREP(Y);
       #endif
       #if HAS_Z_STEP
         PULSE_PREP(Z);
@@ -1814,7 +1997,10 @@ void Stepper::pulse_phase_isr() {
         PULSE_PREP(K);
       #endif
 
-      #if EITHER(LIN_ADVANCE, MIXING_EXTRUDER)
+      #if BOTH(STEP_COMPILER, LIN_ADVANCE)
+        // Don't step E here - But remember the number of steps to perform
+        if (TEST(event_bits, E_AXIS)) motor_direction(E_AXIS) ? --LA_steps : ++LA_steps;
+      #elif EITHER(LIN_ADVANCE, MIXING_EXTRUDER)
         delta_error.e += advance_dividend.e;
         if (delta_error.e >= 0) {
           #if ENABLED(LIN_ADVANCE)
@@ -1943,6 +2129,9 @@ uint32_t Stepper::block_phase_isr() {
           PAGE_SEGMENT_UPDATE_POS(Y);
           PAGE_SEGMENT_UPDATE_POS(Z);
           PAGE_SEGMENT_UPDATE_POS(E);
+
+          // Report the page FREE so the host can send the next one into it
+          page_manager.free_page(current_block->page_idx);
         }
       #endif
       TERN_(HAS_FILAMENT_RUNOUT_DISTANCE, runout.block_completed(current_block));
@@ -1951,14 +2140,48 @@ uint32_t Stepper::block_phase_isr() {
     else {
       // Step events not completed yet...
 
+      #if ENABLED(ARC_BLOCKS)
+        // Set up the next chord of an arc
+        if (IS_ARC(current_block) && !arc_events_left) next_arc_chord();
+      #endif
+
+      #if ENABLED(STEP_COMPILER)
+
+        // The compiler already timed the next group of steps
+        interval = step_event_ticks;
+
+        #if ENABLED(LIN_ADVANCE)
+          // Wake the advance ISR as each phase below does
+          if (step_events_completed <= accelerate_until) {
+            if (LA_use_advance_lead) {
+              if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
+            }
+            else if (LA_steps) nextAdvanceISR = 0;
+          }
+          else if (step_events_completed > decelerate_after) {
+            if (LA_use_advance_lead) {
+              if (step_events_completed <= decelerate_after + steps_per_isr || (LA_steps && LA_isr_rate != current_block->advance_speed)) {
+                initiateLA();
+                LA_isr_rate = current_block->advance_speed;
+              }
+            }
+            else if (LA_steps) nextAdvanceISR = 0;
+          }
+          else if (LA_steps && LA_isr_rate != current_block->advance_speed) initiateLA();
+        #endif
+
+      #else
+
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
         #if ENABLED(S_CURVE_ACCELERATION)
           // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate = acceleration_time < current_block->acceleration_time
-                                   ? _eval_bezier_curve(acceleration_time)
-                                   : current_block->cruise_rate;
+          uint32_t acc_step_rate;
+          if (acceleration_time < current_block->acceleration_time)
+            ISR_PROFILE(ISR_S_CURVE, acc_step_rate = _eval_bezier_curve(acceleration_time));
+          else
+            acc_step_rate = current_block->cruise_rate;
         #else
           acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
           NOMORE(acc_step_rate, current_block->nominal_rate);
@@ -2022,9 +2245,10 @@ uint32_t Stepper::block_phase_isr() {
           }
           else {
             // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
+            if (deceleration_time < current_block->deceleration_time)
+              ISR_PROFILE(ISR_S_CURVE, step_rate = _eval_bezier_curve(deceleration_time));
+            else
+              step_rate = current_block->final_rate;
           }
         #else
 
@@ -2117,12 +2341,19 @@ uint32_t Stepper::block_phase_isr() {
           }
         #endif
       }
+
+      #endif
     }
   }
 
   // If there is no current block at this point, attempt to pop one from the buffer
-  // and prepare its movement
-  if (!current_block) {
+  // and prepare its movement. After an abort, wait for the compiler to start over.
+  if (!current_block && TERN1(STEP_COMPILER, !step_events_resync)) {
+
+    // Have the compiler take the next block, if it hasn't yet
+    #if ENABLED(STEP_COMPILER)
+      if (step_events_tail == step_events_head) compile_steps(1);
+    #endif
 
     // Anything in the buffer?
     if ((current_block = planner.get_current_block())) {
@@ -2146,6 +2377,18 @@ uint32_t Stepper::block_phase_isr() {
           return interval; // No more queued movements!
       }
 
+      #if ENABLED(STEP_COMPILER)
+        // The block's events lead with the timing of its first steps
+        if (step_events_tail == step_events_head) {
+          current_block = nullptr;  // Not pushed yet. Take it again soon.
+          return STEP_EVENT_RETRY_TICKS;
+        }
+        const step_event_t &first = step_events[step_events_tail];
+        const hal_timer_t first_ticks = first.ticks;
+        const uint8_t first_loops = first.loops;
+        step_events_tail = STEP_EVENT_NEXT(step_events_tail);
+      #endif
+
       // For non-inline cutter, grossly apply power
       #if ENABLED(LASER_FEATURE) && DISABLED(LASER_POWER_INLINE)
         cutter.apply_power(current_block->cutter_power);
@@ -2251,17 +2494,47 @@ uint32_t Stepper::block_phase_isr() {
       //if (current_block->steps.c) SBI(axis_bits, Z_HEAD);
       axis_did_move = axis_bits;
 
+      #if ENABLED(STEP_COMPILER)
+
+        // The compiler did the rest, so just count the events
+        step_event_count = current_block->step_event_count;
+        step_events_completed = 0;
+
+        // For Linear Advance
+        accelerate_until = current_block->accelerate_until;
+        decelerate_after = current_block->decelerate_after;
+
+      #else
+
       // No acceleration / deceleration time elapsed so far
       acceleration_time = deceleration_time = 0;
 
       #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
         uint8_t oversampling = 0;                           // Assume no axis smoothing (via oversampling)
-        // Decide if axis smoothing is possible
-        uint32_t max_rate = current_block->nominal_rate;    // Get the step event rate
-        while (max_rate < MIN_STEP_ISR_FREQUENCY) {         // As long as more ISRs are possible...
-          max_rate <<= 1;                                   // Try to double the rate
-          if (max_rate < MIN_STEP_ISR_FREQUENCY)            // Don't exceed the estimated ISR limit
+
+        // Only a motor that steps on some step events, but not all, can alias with them.
+        // Count the stepping motors to get the ISR budget for this block.
+        const uint32_t event_count = current_block->step_event_count;
+        uint8_t moving = 0;
+        bool aliased = false;
+        LOOP_LOGICAL_AXES(i) if (current_block->steps[i]) {
+          moving++;
+          if (current_block->steps[i] < event_count) aliased = true;
+        }
+
+        if (aliased) {
+          static const uint32_t smoothing_limit[] PROGMEM = {
+            MIN_STEP_ISR_FREQUENCY(1), MIN_STEP_ISR_FREQUENCY(2), MIN_STEP_ISR_FREQUENCY(3), MIN_STEP_ISR_FREQUENCY(4),
+            MIN_STEP_ISR_FREQUENCY(5), MIN_STEP_ISR_FREQUENCY(6), MIN_STEP_ISR_FREQUENCY(7)
+          };
+          const uint32_t max_rate = pgm_read_dword(&smoothing_limit[moving - 1]);
+          uint32_t rate = current_block->nominal_rate;      // Get the step event rate
+          while ((rate << 1) < max_rate                     // Don't exceed the estimated ISR limit
+            && event_count < (_BV32(29) >> oversampling)    // Keep the Bresenham terms within 31 bits
+          ) {
+            rate <<= 1;                                     // Double the rate
             ++oversampling;                                 // Increase the oversampling (used for left-shift)
+          }
         }
         oversampling_factor = oversampling;                 // For all timer interval calculations
       #else
@@ -2277,6 +2550,7 @@ uint32_t Stepper::block_phase_isr() {
       // Calculate Bresenham dividends and divisors
       advance_dividend = current_block->steps << 1;
       advance_divisor = step_event_count << 1;
+      TERN_(ARC_BLOCKS, advance_divisor_xy = advance_divisor);
 
       // No step events completed so far
       step_events_completed = 0;
@@ -2285,6 +2559,8 @@ uint32_t Stepper::block_phase_isr() {
       accelerate_until = current_block->accelerate_until << oversampling;
       decelerate_after = current_block->decelerate_after << oversampling;
 
+      #endif
+
       TERN_(MIXING_EXTRUDER, mixer.stepper_setup(current_block->b_color));
 
       E_TERN_(stepper_extruder = current_block->extruder);
@@ -2315,6 +2591,14 @@ uint32_t Stepper::block_phase_isr() {
         set_directions(current_block->direction_bits);
       }
 
+      #if ENABLED(ARC_BLOCKS)
+        // Start on the first chord of an arc
+        if (IS_ARC(current_block)) {
+          arc_chord = 0;
+          next_arc_chord();
+        }
+      #endif
+
       #if ENABLED(LASER_POWER_INLINE)
         const power_status_t stat = current_block->laser.status;
         #if ENABLED(LASER_POWER_INLINE_TRAPEZOID)
@@ -2362,6 +2646,14 @@ uint32_t Stepper::block_phase_isr() {
         if (current_block->steps.z) enable_axis(Z_AXIS);
       #endif
 
+      #if ENABLED(STEP_COMPILER)
+
+        // Wait for the first steps as compiled
+        interval = first_ticks;
+        steps_per_isr = first_loops;
+
+      #else
+
       // Mark the time_nominal as not calculated yet
       ticks_nominal = -1;
 
@@ -2377,6 +2669,8 @@ uint32_t Stepper::block_phase_isr() {
 
       // Calculate the initial timer interval
       interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr);
+
+      #endif
     }
     #if ENABLED(LASER_POWER_INLINE_CONTINUOUS)
       else { // No new block found; so apply inline laser parameters
@@ -2399,6 +2693,32 @@ uint32_t Stepper::block_phase_isr() {
   return interval;
 }
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Set up X and Y to step the next chord of an arc block. The planner has
+   * rounded the chords to whole steps and given each one enough step events
+   * for its longest axis, so this needs no float math.
+   */
+  void Stepper::next_arc_chord() {
+    const block_arc_t &arc = current_block->arc;
+    const xy_int_t &chord = arc.chord[arc_chord++];
+
+    axis_bits_t dm = last_direction_bits;
+    if (chord.x < 0) SBI(dm, X_AXIS); else if (chord.x) CBI(dm, X_AXIS);
+    if (chord.y < 0) SBI(dm, Y_AXIS); else if (chord.y) CBI(dm, Y_AXIS);
+    if (dm != last_direction_bits) set_directions(dm);
+
+    // Bresenham terms for X and Y over the events of the chord
+    arc_events_left = arc.chord_events << oversampling_factor;
+    advance_dividend.x = uint32_t(ABS(chord.x)) << 1;
+    advance_dividend.y = uint32_t(ABS(chord.y)) << 1;
+    advance_divisor_xy = arc_events_left << 1;
+    delta_error.x = delta_error.y = -int32_t(arc_events_left);
+  }
+
+#endif // ARC_BLOCKS
+
 #if ENABLED(LIN_ADVANCE)
 
   // Timer interrupt for E. LA_steps is set in the main routine
@@ -2505,6 +2825,83 @@ uint32_t Stepper::block_phase_isr() {
 
 #endif // LIN_ADVANCE
 
+#if HAS_SHAPING
+
+  // Timer interrupt for shaped X/Y steps. Steps are queued in pulse_phase_isr.
+  uint32_t Stepper::shaping_isr() {
+    uint32_t interval = SHAPING_NEVER;
+
+    #if ISR_MULTI_STEPS
+      USING_TIMED_PULSE();
+    #endif
+
+    #define SHAPING_PHASE(A, S) do{ \
+      int16_t steps = S.due_steps(shaping_time); \
+      if (steps) { \
+        const bool reverse = steps < 0; \
+        if (reverse != S.dir_reverse) { \
+          DIR_WAIT_BEFORE(); \
+          A##_APPLY_DIR(reverse ? INVERT_##A##_DIR : !INVERT_##A##_DIR, false); \
+          DIR_WAIT_AFTER(); \
+          S.dir_reverse = reverse; \
+        } \
+        if (reverse) steps = -steps; \
+        for (;;) { \
+          A##_APPLY_STEP(!INVERT_##A##_STEP_PIN, 0); \
+          TERN_(ISR_MULTI_STEPS, START_HIGH_PULSE()); \
+          TERN_(ISR_MULTI_STEPS, AWAIT_HIGH_PULSE()); \
+          A##_APPLY_STEP(INVERT_##A##_STEP_PIN, 0); \
+          if (!--steps) break; \
+          TERN_(ISR_MULTI_STEPS, START_LOW_PULSE()); \
+          TERN_(ISR_MULTI_STEPS, AWAIT_LOW_PULSE()); \
+        } \
+      } \
+      if (S.has_staged && S.idle()) { S.set_params(S.staged); S.has_staged = false; } \
+      NOMORE(interval, S.next_due(shaping_time)); \
+    }while(0)
+
+    TERN_(INPUT_SHAPING_X, SHAPING_PHASE(X, shaper_x));
+    TERN_(INPUT_SHAPING_Y, SHAPING_PHASE(Y, shaper_y));
+
+    return interval;
+  }
+
+  void Stepper::set_shaping(AxisShaper &shaper, const shaping_settings_t &s) {
+    shaping_params_t p;
+    AxisShaper::calculate(s, p);
+
+    const bool was_on = suspend();
+    shaper.settings = s;
+    if (shaper.idle()) {
+      shaper.set_params(p);
+      shaper.has_staged = false;
+    }
+    else {
+      shaper.staged = p;
+      shaper.has_staged = true;
+    }
+    if (was_on) wake_up();
+  }
+
+  bool Stepper::shaping_idle() {
+    return true
+      #if ENABLED(INPUT_SHAPING_X)
+        && shaper_x.idle() && !shaper_x.has_staged
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+        && shaper_y.idle() && !shaper_y.has_staged
+      #endif
+    ;
+  }
+
+  void Stepper::flush_shaping() {
+    TERN_(INPUT_SHAPING_X, count_position.x -= shaper_x.flush());
+    TERN_(INPUT_SHAPING_Y, count_position.y -= shaper_y.flush());
+    nextShapingISR = SHAPING_NEVER;
+  }
+
+#endif // HAS_SHAPING
+
 #if ENABLED(INTEGRATED_BABYSTEPPING)
 
   // Timer interrupt for baby-stepping
@@ -2515,33 +2912,166 @@ uint32_t Stepper::block_phase_isr() {
 
 #endif
 
-// Check if the given block is busy or not - Must not be called from ISR contexts
-// The current_block could change in the middle of the read by an Stepper ISR, so
-// we must explicitly prevent that!
-bool Stepper::is_block_busy(const block_t * const block) {
-  #ifdef __AVR__
-    // A SW memory barrier, to ensure GCC does not overoptimize loops
-    #define sw_barrier() asm volatile("": : :"memory");
-
-    // Keep reading until 2 consecutive reads return the same value,
-    // meaning there was no update in-between caused by an interrupt.
-    // This works because stepper ISRs happen at a slower rate than
-    // successive reads of a variable, so 2 consecutive reads with
-    // the same value means no interrupt updated it.
-    block_t *vold, *vnew = current_block;
-    sw_barrier();
-    do {
-      vold = vnew;
-      vnew = current_block;
+#if ENABLED(STEP_COMPILER)
+
+  // A SW memory barrier, so the events are stored before they're handed over
+  #define sw_barrier() asm volatile("": : :"memory");
+
+  /**
+   * Run the Bresenham line tracer and the trapezoid generator ahead of the
+   * Stepper ISR. Each group of events holds the steps of one Stepper ISR,
+   * with the time to the next group and its number of steps in the first.
+   * These are the same groups and times as block_phase_isr gives without
+   * the compiler, so multi-stepping is kept.
+   *
+   * Called from the Temperature ISR to keep the buffer full, and from the
+   * Stepper ISR when it runs out. Only one caller compiles at a time. The
+   * Stepper ISR doesn't touch the trapezoid state, so it's the compiler's.
+   */
+  void Stepper::compile_steps(const uint8_t min_events/*=(STEP_EVENT_BUFFER_SIZE) - 1*/) {
+    if (compiling) return;  // Interrupted another caller. Leave it to finish.
+    compiling = true;
+
+    // The ISR dropped a block. Drop its events and any compiled after it.
+    if (step_events_resync) {
+      const bool was_on = suspend();
+      flush_step_events();
+      planner.block_buffer_nonbusy = planner.block_buffer_tail;
+      if (was_on) wake_up();
+    }
+
+    uint8_t head = step_events_head, added = 0;
+    while (added < min_events) {
+      const uint8_t room = uint8_t(step_events_tail - head - 1) & ((STEP_EVENT_BUFFER_SIZE) - 1);
+
+      if (!compile_block) {
+        if (!room) break;
+
+        // Leave the next block to the planner while the buffer lasts through the next Temperature ISRs.
+        // A block taken early can't speed up with the blocks that arrive after it.
+        const uint8_t queued = uint8_t(head - step_events_tail) & ((STEP_EVENT_BUFFER_SIZE) - 1);
+        if (min_events > 1 && uint32_t(queued) * compile_ticks >= uint32_t(compile_loops) * (STEP_EVENT_LEAD_TICKS)) break;
+
+        block_t * const block = planner.get_compile_block();
+        if (!block) break;
+
+        // The ISR handles sync blocks by itself
+        if (block->flag & BLOCK_MASK_SYNC) continue;
+
+        compile_block = block;
+        compiled_events = 0;
+
+        // Initialize Bresenham delta errors to 1/2
+        delta_error = -int32_t(block->step_event_count);
+        advance_dividend = block->steps << 1;
+        advance_divisor = block->step_event_count << 1;
+
+        acceleration_time = deceleration_time = 0;
+        ticks_nominal = -1;
+
+        #if ENABLED(S_CURVE_ACCELERATION)
+          _calc_bezier_curve_coeffs(block->initial_rate, block->cruise_rate, block->acceleration_time_inverse);
+          bezier_2nd_half = false;
+        #else
+          acc_step_rate = block->initial_rate;
+        #endif
+
+        // Lead with the time to the first steps
+        step_event_t &event = step_events[head];
+        event.ticks = compile_ticks = calc_timer_interval(block->initial_rate, &compile_loops);
+        event.loops = compile_loops;
+        event.bits = STEP_EVENT_START;
+        head = STEP_EVENT_NEXT(head);
+        added++;
+      }
+      else {
+        // The steps of the next Stepper ISR, as pulse_phase_isr takes them
+        const uint8_t loops = _MIN(compile_block->step_event_count - compiled_events, uint32_t(compile_loops));
+        if (room < loops) break;
+        compiled_events += loops;
+
+        // Time the Stepper ISR after these steps, as block_phase_isr does without the compiler
+        step_event_t &first = step_events[head];
+        if (compiled_events < compile_block->step_event_count) {
+          uint32_t interval;
+          if (compiled_events <= compile_block->accelerate_until) {
+            #if ENABLED(S_CURVE_ACCELERATION)
+              const uint32_t acc_step_rate = acceleration_time < compile_block->acceleration_time
+                                             ? _eval_bezier_curve(acceleration_time)
+                                             : compile_block->cruise_rate;
+            #else
+              acc_step_rate = STEP_MULTIPLY(acceleration_time, compile_block->acceleration_rate) + compile_block->initial_rate;
+              NOMORE(acc_step_rate, compile_block->nominal_rate);
+            #endif
+            interval = calc_timer_interval(acc_step_rate, &compile_loops);
+            acceleration_time += interval;
+          }
+          else if (compiled_events > compile_block->decelerate_after) {
+            uint32_t step_rate;
+            #if ENABLED(S_CURVE_ACCELERATION)
+              if (!bezier_2nd_half) {
+                _calc_bezier_curve_coeffs(compile_block->cruise_rate, compile_block->final_rate, compile_block->deceleration_time_inverse);
+                bezier_2nd_half = true;
+                step_rate = compile_block->cruise_rate;
+              }
+              else
+                step_rate = deceleration_time < compile_block->deceleration_time
+                  ? _eval_bezier_curve(deceleration_time)
+                  : compile_block->final_rate;
+            #else
+              step_rate = STEP_MULTIPLY(deceleration_time, compile_block->acceleration_rate);
+              if (step_rate < acc_step_rate) {
+                step_rate = acc_step_rate - step_rate;
+                NOLESS(step_rate, compile_block->final_rate);
+              }
+              else
+                step_rate = compile_block->final_rate;
+            #endif
+            interval = calc_timer_interval(step_rate, &compile_loops);
+            deceleration_time += interval;
+          }
+          else {
+            // Ticks at the nominal speed, if not done yet
+            if (ticks_nominal < 0) ticks_nominal = calc_timer_interval(compile_block->nominal_rate, &compile_loops);
+            interval = ticks_nominal;
+          }
+          first.ticks = compile_ticks = interval;
+        }
+        first.loops = compile_loops;
+
+        // Trace the line
+        for (uint8_t n = loops; n--;) {
+          uint8_t bits = 0;
+          LOOP_LOGICAL_AXES(i) {
+            delta_error[i] += advance_dividend[i];
+            if (delta_error[i] >= 0) {
+              delta_error[i] -= advance_divisor;
+              SBI(bits, i);
+            }
+          }
+          step_events[head].bits = bits;
+          head = STEP_EVENT_NEXT(head);
+        }
+        added += loops;
+
+        if (compiled_events >= compile_block->step_event_count) compile_block = nullptr;
+      }
+
+      // Hand the group over to the ISR
       sw_barrier();
-    } while (vold != vnew);
-  #else
-    block_t *vnew = current_block;
-  #endif
+      step_events_head = head;
+    }
 
-  // Return if the block is busy or not
-  return block == vnew;
-}
+    compiling = false;
+  }
+
+  void Stepper::flush_step_events() {
+    step_events_tail = step_events_head;
+    compile_block = nullptr;
+    step_events_resync = false;
+  }
+
+#endif // STEP_COMPILER
 
 void Stepper::init() {
 
@@ -2786,6 +3316,14 @@ void Stepper::init() {
     )
   );
 
+  // Shaped axes start out going forward
+  #if ENABLED(INPUT_SHAPING_X)
+    X_APPLY_DIR(!INVERT_X_DIR, false);
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    Y_APPLY_DIR(!INVERT_Y_DIR, false);
+  #endif
+
   #if HAS_MOTOR_CURRENT_SPI || HAS_MOTOR_CURRENT_PWM
     initialized = true;
     digipot_init();
@@ -2878,6 +3416,10 @@ void Stepper::set_axis_position(const AxisEnum a, const int32_t &v) {
 void Stepper::endstop_triggered(const AxisEnum axis) {
 
   const bool was_enabled = suspend();
+
+  // Shaped axes report where the motor is, not where it was commanded to go
+  TERN_(HAS_SHAPING, flush_shaping());
+
   endstops_trigsteps[axis] = (
     #if IS_CORE
       (axis == CORE_AXIS_2
@@ -45,6 +45,10 @@
 
 #include "planner.h"
 #include "stepper/indirection.h"
+
+#if HAS_SHAPING
+  #include "input_shaping.h"
+#endif
 #ifdef __AVR__
   #include "speed_lookuptable.h"
 #endif
@@ -85,8 +89,8 @@
     #define ISR_LA_BASE_CYCLES 0UL
   #endif
 
-  // S curve interpolation adds 40 cycles
-  #if ENABLED(S_CURVE_ACCELERATION)
+  // S curve interpolation adds 40 cycles, unless it's compiled ahead
+  #if ENABLED(S_CURVE_ACCELERATION) && DISABLED(STEP_COMPILER)
     #define ISR_S_CURVE_CYCLES 40UL
   #else
     #define ISR_S_CURVE_CYCLES 0UL
@@ -115,8 +119,9 @@
     #define ISR_LA_BASE_CYCLES 0UL
   #endif
 
-  // S curve interpolation adds 160 cycles
-  #if ENABLED(S_CURVE_ACCELERATION)
+  // S curve interpolation adds 160 cycles, unless it's compiled ahead. S_CURVE_TABLE gets the
+  // same budget until it's measured. ISR_PROFILER times it as " S-curve" in the M578 report.
+  #if ENABLED(S_CURVE_ACCELERATION) && DISABLED(STEP_COMPILER)
     #define ISR_S_CURVE_CYCLES 160UL
   #else
     #define ISR_S_CURVE_CYCLES 0UL
@@ -231,10 +236,31 @@
 #define MAX_STEP_ISR_FREQUENCY_2X   ((F_CPU) / ISR_EXECUTION_CYCLES(2))
 #define MAX_STEP_ISR_FREQUENCY_1X   ((F_CPU) / ISR_EXECUTION_CYCLES(1))
 
-// The minimum step ISR rate used by ADAPTIVE_STEP_SMOOTHING to target 50% CPU usage
-// This does not account for the possibility of multi-stepping.
-// Perhaps DISABLE_MULTI_STEPPING should be required with ADAPTIVE_STEP_SMOOTHING.
-#define MIN_STEP_ISR_FREQUENCY (MAX_STEP_ISR_FREQUENCY_1X / 2)
+// The step ISR rate used by ADAPTIVE_STEP_SMOOTHING to target 50% CPU usage with N motors stepping.
+// Oversampled events only pulse the motors in the current block, leaving more room for fewer motors.
+#define ISR_SMOOTHING_CYCLES(N) (ISR_BASE_CYCLES + ISR_S_CURVE_CYCLES + ISR_LOOP_BASE_CYCLES + _MAX(MIN_STEPPER_PULSE_CYCLES, ISR_MIXING_STEPPER_CYCLES + (N) * (ISR_STEPPER_CYCLES)) + ISR_LA_BASE_CYCLES + ISR_LA_LOOP_CYCLES)
+#define MIN_STEP_ISR_FREQUENCY(N) ((F_CPU) / ISR_SMOOTHING_CYCLES(N) / 2)
+
+#if ENABLED(STEP_COMPILER)
+  // A step event compiled ahead of the Stepper ISR. The first event
+  // of each Stepper ISR's group also holds the timing of the next group.
+  typedef struct {
+    hal_timer_t ticks;  // Ticks from this group to the next
+    uint8_t loops,      // Steps in the next group
+            bits;       // Motors to step, by AxisEnum, or STEP_EVENT_START
+  } step_event_t;
+
+  // Leads each block's events, with the timing of its first group
+  #define STEP_EVENT_START _BV(7)
+
+  #define STEP_EVENT_NEXT(I) uint8_t(((I) + 1) & ((STEP_EVENT_BUFFER_SIZE) - 1))
+
+  // How far ahead of the Stepper ISR to compile, in ticks. Two Temperature ISR periods.
+  #define STEP_EVENT_LEAD_TICKS uint32_t(2UL * (STEPPER_TIMER_RATE) / (TEMP_TIMER_FREQUENCY))
+
+  // How soon the ISR checks back when it interrupted the compiler mid-group
+  #define STEP_EVENT_RETRY_TICKS ((STEPPER_TIMER_RATE) / 20000UL)
+#endif
 
 #define ENABLE_COUNT (LINEAR_AXES + E_STEPPERS)
 typedef IF<(ENABLE_COUNT > 8), uint16_t, uint8_t>::type ena_mask_t;
@@ -339,6 +365,11 @@ class Stepper {
 
   private:
 
+    #if ENABLED(PLANNER_BENCHMARK)
+      // The LINUX HAL benchmark checks where the steppers end up
+      friend class PlannerBenchmark;
+    #endif
+
     static block_t* current_block;          // A pointer to the block currently being traced
 
     static axis_bits_t last_direction_bits, // The next stepping-bits to be output
@@ -388,13 +419,20 @@ class Stepper {
     #endif
 
     #if ENABLED(S_CURVE_ACCELERATION)
-      static int32_t bezier_A,     // A coefficient in Bézier speed curve
-                     bezier_B,     // B coefficient in Bézier speed curve
-                     bezier_C;     // C coefficient in Bézier speed curve
-      static uint32_t bezier_F,    // F coefficient in Bézier speed curve
-                      bezier_AV;   // AV coefficient in Bézier speed curve
-      #ifdef __AVR__
-        static bool A_negative;    // If A coefficient was negative
+      #if ENABLED(S_CURVE_TABLE)
+        static uint32_t bezier_F,  // Speed at the start of the curve
+                        bezier_dV, // Speed change across the curve
+                        bezier_AV; // Inverse of the curve duration
+        static bool bezier_slowing; // If the speed drops across the curve
+      #else
+        static int32_t bezier_A,   // A coefficient in Bézier speed curve
+                       bezier_B,   // B coefficient in Bézier speed curve
+                       bezier_C;   // C coefficient in Bézier speed curve
+        static uint32_t bezier_F,  // F coefficient in Bézier speed curve
+                        bezier_AV; // AV coefficient in Bézier speed curve
+        #ifdef __AVR__
+          static bool A_negative;  // If A coefficient was negative
+        #endif
       #endif
       static bool bezier_2nd_half; // If Bézier curve has been initialized or not
     #endif
@@ -412,10 +450,35 @@ class Stepper {
       static uint32_t nextBabystepISR;
     #endif
 
+    #if HAS_SHAPING
+      static constexpr uint32_t SHAPING_NEVER = 0xFFFFFFFF;
+      static uint32_t nextShapingISR,
+                      shaping_time;   // (ticks) Stepper ISR time, for the shaping queues
+    #endif
+
     #if ENABLED(DIRECT_STEPPING)
       static page_step_state_t page_step_state;
     #endif
 
+    #if ENABLED(ARC_BLOCKS)
+      static uint32_t advance_divisor_xy,     // Bresenham divisor for X and Y, which differs by chord in an arc block
+                      arc_events_left;        // Step events left in the current chord
+      static uint8_t arc_chord;               // The next chord of the arc block
+    #endif
+
+    #if ENABLED(STEP_COMPILER)
+      static step_event_t step_events[STEP_EVENT_BUFFER_SIZE];
+      static volatile uint8_t step_events_head,   // Written by compile_steps()
+                              step_events_tail;   // Written by the Stepper ISR
+      static volatile bool step_events_resync;    // The ISR dropped a block, so recompile from the planner tail
+      static hal_timer_t step_event_ticks;        // Ticks after the last replayed group
+      static volatile bool compiling;             // Set while compile_steps() runs
+      static block_t *compile_block;              // The block being compiled, if any
+      static uint32_t compiled_events;            // Step events compiled for compile_block
+      static uint8_t compile_loops;               // Steps in the next group to compile
+      static hal_timer_t compile_ticks;           // Ticks of the last group compiled
+    #endif
+
     static int32_t ticks_nominal;
     #if DISABLED(S_CURVE_ACCELERATION)
       static uint32_t acc_step_rate; // needed for deceleration start point
@@ -450,6 +513,13 @@ class Stepper {
     #endif
 
   public:
+    #if ENABLED(INPUT_SHAPING_X)
+      static AxisShaper shaper_x;
+    #endif
+    #if ENABLED(INPUT_SHAPING_Y)
+      static AxisShaper shaper_y;
+    #endif
+
     // Initialize stepper hardware
     static void init();
 
@@ -493,8 +563,28 @@ class Stepper {
       }
     #endif
 
-    // Check if the given block is busy or not - Must not be called from ISR contexts
-    static bool is_block_busy(const block_t * const block);
+    #if HAS_SHAPING
+      // The Input Shaping ISR phase
+      static uint32_t shaping_isr();
+
+      // Change the shaper settings. New impulses apply once the shaper has no steps queued.
+      static void set_shaping(AxisShaper &shaper, const shaping_settings_t &s);
+
+      // All shaped steps taken and all new settings applied?
+      static bool shaping_idle();
+
+      // Drop the shaped steps not yet taken and count the motors back to where they are
+      static void flush_shaping();
+    #endif
+
+    #if ENABLED(STEP_COMPILER)
+      // Compile upcoming blocks into step events for the ISR to replay, until at least min_events
+      // are added, the buffer is full, or it holds enough to start no new block - Called from ISRs
+      static void compile_steps(const uint8_t min_events=(STEP_EVENT_BUFFER_SIZE) - 1);
+
+      // Drop all compiled step events - Call with the Stepper ISR suspended
+      static void flush_step_events();
+    #endif
 
     // Get the position of a stepper, in steps
     static int32_t position(const AxisEnum axis);
@@ -635,6 +725,11 @@ class Stepper {
     // Set the current position in steps
     static void _set_position(const abce_long_t &spos);
 
+    #if ENABLED(ARC_BLOCKS)
+      // Set up X and Y to step the next chord of an arc block
+      static void next_arc_chord();
+    #endif
+
     FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t *loops) {
       uint32_t timer;
 
@@ -672,12 +767,11 @@ class Stepper {
         // In case of high-performance processor, it is able to calculate in real-time
         timer = uint32_t(STEPPER_TIMER_RATE) / step_rate;
       #else
-        constexpr uint32_t min_step_rate = (F_CPU) / 500000U;
-        NOLESS(step_rate, min_step_rate);
-        step_rate -= min_step_rate; // Correct for minimal speed
+        NOLESS(step_rate, uint32_t(SPEED_TABLE_MIN_RATE));
+        step_rate -= SPEED_TABLE_MIN_RATE; // Correct for minimal speed
         if (step_rate >= (8 * 256)) { // higher step rate
-          const uint8_t tmp_step_rate = (step_rate & 0x00FF);
-          const uint16_t table_address = (uint16_t)&speed_lookuptable_fast[(uint8_t)(step_rate >> 8)][0],
+          const uint8_t tmp_step_rate = uint8_t(step_rate << (8 - SPEED_TABLE_FAST_SHIFT));
+          const uint16_t table_address = (uint16_t)&speed_lookuptable_fast[uint16_t(step_rate) >> SPEED_TABLE_FAST_SHIFT][0],
                          gain = (uint16_t)pgm_read_word(table_address + 2);
           timer = MultiU16X8toH16(tmp_step_rate, gain);
           timer = (uint16_t)pgm_read_word(table_address) - timer;
@@ -686,7 +780,7 @@ class Stepper {
           uint16_t table_address = (uint16_t)&speed_lookuptable_slow[0][0];
           table_address += ((step_rate) >> 1) & 0xFFFC;
           timer = (uint16_t)pgm_read_word(table_address)
-                - (((uint16_t)pgm_read_word(table_address + 2) * (uint8_t)(step_rate & 0x0007)) >> 3);
+                - (((uint16_t)pgm_read_word(table_address + 2) * (uint8_t)(step_rate & 0x0007) + TERN0(HIRES_SPEED_LOOKUPTABLE, 4)) >> 3);
         }
         // (there is no need to limit the timer value here. All limits have been
         // applied above, and AVR is able to keep up at 30khz Stepping ISR rate)
@@ -29,6 +29,7 @@
 
 #include "../MarlinCore.h"
 #include "../HAL/shared/Delay.h"
+#include "../feature/isr_profiler.h"
 #include "../lcd/marlinui.h"
 
 #include "temperature.h"
@@ -141,7 +142,7 @@
   #endif
 #endif
 
-#if ENABLED(PID_EXTRUSION_SCALING)
+#if EITHER(PID_EXTRUSION_SCALING, STEP_COMPILER)
   #include "stepper.h"
 #endif
 
@@ -2978,7 +2979,7 @@ void Temperature::readings_ready() {
 HAL_TEMP_TIMER_ISR() {
   HAL_timer_isr_prologue(MF_TIMER_TEMP);
 
-  Temperature::isr();
+  ISR_PROFILE_INTERRUPT(ISR_TEMPERATURE, Temperature::isr());
 
   HAL_timer_isr_epilogue(MF_TIMER_TEMP);
 }
@@ -3525,6 +3526,9 @@ void Temperature::isr() {
   // Poll endstops state, if required
   endstops.poll();
 
+  // Keep the Stepper ISR supplied with step events
+  TERN_(STEP_COMPILER, stepper.compile_steps());
+
   // Periodically call the planner timer service routine
   planner.isr();
 }
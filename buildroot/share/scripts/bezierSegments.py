@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+Compare the ways the firmware can split G5 Bézier curves into line segments.
+
+For each G5 in a G-code file this splits the curve with the stock fixed step
+search (MIN_STEP, MAX_STEP and SIGMA in planner_bezier.cpp) and with the
+BEZIER_FLATNESS step, then shows the segments each one buffers, the curve points
+each one has to evaluate, and how far any chord strays from the curve.
+
+  bezierSegments.py in.gcode [--flatness 50] [--verbose]
+
+Without a file a set of sample curves is used.
+"""
+
+from __future__ import print_function, division
+
+import argparse, math, re
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('gcode', nargs='?', help='G-code file with G5 moves')
+parser.add_argument('--flatness', type=float, default=50, help='BEZIER_FLATNESS, µm (default=50)')
+parser.add_argument('--verbose', action='store_true', help='Show each curve')
+args = parser.parse_args()
+
+# Stock constants
+MIN_STEP, MAX_STEP, SIGMA = 0.002, 0.1, 0.1
+
+# Curves as (start, first control, second control, end)
+SAMPLES = [
+  ((0, 0), (0, 5), (5, 5), (5, 0)),         # Arch
+  ((0, 0), (1, 0.1), (2, -0.1), (3, 0)),    # Nearly straight
+  ((0, 0), (0.5, 0.5), (1, 0.5), (1.5, 0)), # Short
+  ((0, 0), (30, 20), (-10, 20), (20, 0)),   # Loop
+  ((0, 0), (10, 10), (20, -10), (30, 0)),   # S-bend
+  ((0, 0), (60, 0), (60, 60), (0, 60)),     # Big bow
+  ((0, 0), (2, 2), (-2, 2), (0, 0))         # Cusp, closed
+]
+
+def bezier(c, t):
+  mt = 1 - t
+  return tuple(mt**3 * a + 3 * mt * mt * t * b + 3 * mt * t * t * q + t**3 * d for a, b, q, d in zip(*c))
+
+def dist1(p, q): return abs(p[0] - q[0]) + abs(p[1] - q[1])
+
+def stock_split(c):
+  """ cubic_b_spline() without BEZIER_FLATNESS """
+  ts, evals, t, step, pos = [ 0 ], 0, 0, MAX_STEP, c[0]
+  while t < 1:
+    did_reduce = False
+    new_t = min(t + step, 1)
+    new_pos = bezier(c, new_t); evals += 1
+    while new_t - t >= MIN_STEP:
+      cand_t = 0.5 * (t + new_t)
+      cand = bezier(c, cand_t); evals += 1
+      if dist1(cand, ((pos[0] + new_pos[0]) / 2, (pos[1] + new_pos[1]) / 2)) <= SIGMA: break
+      new_t, new_pos, did_reduce = cand_t, cand, True
+    if not did_reduce:
+      while new_t - t <= MAX_STEP:
+        cand_t = t + 2 * (new_t - t)
+        if cand_t >= 1: break
+        cand = bezier(c, cand_t); evals += 1
+        if dist1(new_pos, ((pos[0] + cand[0]) / 2, (pos[1] + cand[1]) / 2)) > SIGMA: break
+        new_t, new_pos = cand_t, cand
+    step, t, pos = new_t - t, new_t, new_pos
+    ts.append(t)
+  return ts, evals
+
+def flat_split(c):
+  """ cubic_b_spline() with BEZIER_FLATNESS """
+  p0, p1, p2, p3 = c
+  dd0 = [ 6 * (a - 2 * b + q) for a, b, q in zip(p0, p1, p2) ]
+  dd1 = [ 6 * (d - a + 3 * (b - q)) for a, b, q, d in zip(p0, p1, p2, p3) ]
+  limit = 8 * args.flatness / 1000
+  def mag(t): return math.hypot(dd0[0] + dd1[0] * t, dd0[1] + dd1[1] * t)
+  ts, evals, t = [ 0 ], 0, 0
+  while t < 1:
+    h, m = 1 - t, mag(t)
+    if m > limit: h = min(h, math.sqrt(limit / m))
+    m = mag(t + h)
+    if m > limit: h = min(h, math.sqrt(limit / m))
+    if t + h < 1 and t + 2 * h > 1: h = (1 - t) / 2
+    t += h
+    if t < 1: evals += 1
+    ts.append(min(t, 1))
+  return ts, evals
+
+def seg_dist(p, a, b):
+  dx, dy = b[0] - a[0], b[1] - a[1]
+  l2 = dx * dx + dy * dy
+  u = max(0, min(1, ((p[0] - a[0]) * dx + (p[1] - a[1]) * dy) / l2)) if l2 else 0
+  return math.hypot(p[0] - a[0] - u * dx, p[1] - a[1] - u * dy)
+
+def deviation(c, ts):
+  """ The farthest any chord strays from its span of the curve """
+  worst = 0
+  for t0, t1 in zip(ts, ts[1:]):
+    a, b = bezier(c, t0), bezier(c, t1)
+    for i in range(1, 16):
+      worst = max(worst, seg_dist(bezier(c, t0 + (t1 - t0) * i / 16), a, b))
+  return worst
+
+def curves_in(path):
+  """ Each G5 in the file as control points, following G0-G3, G90/G91 and G92 """
+  pos, relative = [ 0.0, 0.0 ], False
+  for line in open(path):
+    line = line.split(';')[0].strip().upper()
+    if not line: continue
+    words = dict((m[0], float(m[1:])) for m in re.findall(r'[A-Z][-+.0-9]+', line))
+    g = words.get('G')
+    if g == 90: relative = False
+    elif g == 91: relative = True
+    elif g == 92: pos = [ words.get('X', pos[0]), words.get('Y', pos[1]) ]
+    elif g in (0, 1, 2, 3, 5):
+      end = [ pos[i] + words.get(a, 0) if relative else words.get(a, pos[i]) for i, a in enumerate('XY') ]
+      if g == 5:
+        yield (tuple(pos), (pos[0] + words.get('I', 0), pos[1] + words.get('J', 0)),
+               (end[0] + words.get('P', 0), end[1] + words.get('Q', 0)), tuple(end))
+      pos = end
+
+curves = list(curves_in(args.gcode)) if args.gcode else SAMPLES
+if not curves: parser.error('no G5 moves in ' + args.gcode)
+
+totals = { 'stock': [ 0, 0, 0 ], 'flat': [ 0, 0, 0 ] }
+for c in curves:
+  row = []
+  for name, split in (('stock', stock_split), ('flat', flat_split)):
+    ts, evals = split(c)
+    dev, tot = deviation(c, ts), totals[name]
+    tot[0] += len(ts) - 1; tot[1] += evals; tot[2] = max(tot[2], dev)
+    row.append('%s %4d segments %5d evals %7.1f µm' % (name, len(ts) - 1, evals, dev * 1000))
+  if args.verbose: print(' | '.join(row))
+
+print('%d curves, BEZIER_FLATNESS %g µm' % (len(curves), args.flatness))
+for name, (segs, evals, dev) in sorted(totals.items(), reverse=True):
+  print('  %-5s %7d segments %8d curve points evaluated, worst chord %7.1f µm' % (name, segs, evals, dev * 1000))
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+Check that ABL_BILINEAR_PATCHES gives the same bed leveling Z as the stock code,
+and that ABL_BILINEAR_FIXED_POINT stays within its error bound.
+
+Random bilinear meshes are looked up at random points on and around the grid
+with the stock bilinear_z_offset() and with the per-cell patch table, both in
+single precision, and compared with the exact value worked out in double
+precision. Points beyond the grid are tried with and without
+EXTRAPOLATE_BEYOND_GRID. The fixed-point lookup is done in integers as the
+firmware does it, and only without EXTRAPOLATE_BEYOND_GRID.
+
+The exit status is 1 if any float lookup differs from the stock one by more
+than the tolerance, or any fixed-point lookup by more than the bound.
+
+  bilinearPatches.py [--meshes 100] [--points 1000] [--tolerance 0.01] [--bound 3.5] [--seed 1]
+"""
+
+from __future__ import print_function, division
+
+import argparse, math, random, struct, sys
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('--meshes', type=int, default=100, help='Random meshes to try (default=100)')
+parser.add_argument('--points', type=int, default=1000, help='Lookups per mesh (default=1000)')
+parser.add_argument('--tolerance', type=float, default=0.01, help='Largest allowed difference, µm (default=0.01)')
+parser.add_argument('--bound', type=float, default=3.5, help='Largest allowed fixed-point error, µm (default=3.5)')
+parser.add_argument('--seed', type=int, default=1, help='Random seed (default=1)')
+args = parser.parse_args()
+
+def f32(v):
+  """ Round to a 32-bit float, as each step of the firmware math does """
+  return struct.unpack('f', struct.pack('f', v))[0]
+
+def constrain(v, lo, hi): return min(max(v, lo), hi)
+
+def term(z):
+  """ PATCH_TERM() with ABL_BILINEAR_FIXED_POINT, a height in whole µm """
+  return int(constrain(math.floor(abs(z) * 1000 + 0.5) * (1 if z >= 0 else -1), -32767, 32767))
+
+def trunc16(v):
+  """ Keep the low 16 bits as a signed value, like a cast to int16_t """
+  v &= 0xFFFF
+  return v - 0x10000 if v & 0x8000 else v
+
+class Mesh:
+  def __init__(self, nx, ny):
+    self.nx, self.ny = nx, ny
+    self.start = [ f32(random.uniform(-20, 40)), f32(random.uniform(-20, 40)) ]
+    self.spacing = [ f32(random.uniform(10, 300) / (nx - 1)), f32(random.uniform(10, 300) / (ny - 1)) ]
+    self.factor = [ f32(1 / s) for s in self.spacing ]
+    tilt = [ random.uniform(-0.004, 0.004), random.uniform(-0.004, 0.004) ]
+    self.z = [ [ f32(tilt[0] * x * self.spacing[0] + tilt[1] * y * self.spacing[1] + random.uniform(-0.3, 0.3))
+                 for y in range(ny) ] for x in range(nx) ]
+    # refresh_bed_level()
+    self.patches = [ [ None ] * (ny - 1) for _ in range(nx - 1) ]
+    for x in range(nx - 1):
+      for y in range(ny - 1):
+        z1, z2, z3, z4 = self.z[x][y], self.z[x][y + 1], self.z[x + 1][y], self.z[x + 1][y + 1]
+        c = f32(z2 - z1)
+        self.patches[x][y] = (z1, f32(z3 - z1), c, f32(f32(z4 - z3) - c))
+    self.cell_factor = [ f32(f * 65536) for f in self.factor ]
+    self.fixed_patches = [ [ tuple(term(z) for z in p) for p in col ] for col in self.patches ]
+
+  def stock(self, raw, extrapolate):
+    """ bilinear_z_offset() without ABL_BILINEAR_PATCHES """
+    box = 2 if extrapolate else 1
+    ratio, thisg, nextg = [], [], []
+    for i, n in enumerate((self.nx, self.ny)):
+      r = f32(f32(raw[i] - self.start[i]) * self.factor[i])
+      g = constrain(math.floor(r), 0, n - box)
+      r = f32(r - g)
+      if not extrapolate: r = max(r, 0)
+      ratio.append(r); thisg.append(g); nextg.append(min(g + 1, n - 1))
+    z1 = self.z[thisg[0]][thisg[1]]
+    d2 = f32(self.z[thisg[0]][nextg[1]] - z1)
+    z3 = self.z[nextg[0]][thisg[1]]
+    d4 = f32(self.z[nextg[0]][nextg[1]] - z3)
+    L = f32(z1 + f32(d2 * ratio[1]))
+    R = f32(z3 + f32(d4 * ratio[1]))
+    return f32(L + f32(ratio[0] * f32(R - L)))
+
+  def patch(self, raw, extrapolate):
+    """ bilinear_z_offset() with ABL_BILINEAR_PATCHES """
+    uv, cell = [], []
+    for i, n in enumerate((self.nx, self.ny)):
+      t = f32(f32(raw[i] - self.start[i]) * self.factor[i])
+      if not extrapolate: t = constrain(t, 0, n - 1)
+      g = constrain(math.floor(t), 0, n - 2)
+      uv.append(f32(t - g)); cell.append(g)
+    a, b, c, d = self.patches[cell[0]][cell[1]]
+    u, v = uv
+    return f32(f32(a + f32(b * u)) + f32(v * f32(c + f32(d * u))))
+
+  def fixed(self, raw):
+    """ bilinear_z_offset() with ABL_BILINEAR_FIXED_POINT """
+    q = []
+    for i, n in enumerate((self.nx, self.ny)):
+      t = int(f32(f32(raw[i] - self.start[i]) * self.cell_factor[i]))  # Truncates, like the cast
+      q.append(constrain(t, 0, ((n - 1) << 16) - 1))
+    a, b, c, d = self.fixed_patches[q[0] >> 16][q[1] >> 16]
+    fu, fv = q[0] & 0xFFFF, q[1] & 0xFFFF
+    def q16_mul(z, f): return (z * f + 0x8000) >> 16
+    cd = trunc16(c + q16_mul(d, fu))
+    return f32((a + q16_mul(b, fu) + q16_mul(cd, fv)) * f32(0.001))
+
+  def exact(self, raw, extrapolate):
+    """ The bilinear surface in double precision """
+    uv, cell = [], []
+    for i, n in enumerate((self.nx, self.ny)):
+      t = (raw[i] - self.start[i]) / self.spacing[i]
+      if not extrapolate: t = constrain(t, 0, n - 1)
+      g = constrain(math.floor(t), 0, n - 2)
+      uv.append(t - g); cell.append(g)
+    (x, y), (u, v) = cell, uv
+    z = self.z
+    return (z[x][y] * (1 - u) * (1 - v) + z[x + 1][y] * u * (1 - v)
+          + z[x][y + 1] * (1 - u) * v + z[x + 1][y + 1] * u * v)
+
+random.seed(args.seed)
+failed = False
+for extrapolate in (False, True):
+  lookups = same = 0
+  worst_diff = worst_stock = worst_patch = worst_fixed = 0
+  for _ in range(args.meshes):
+    mesh = Mesh(random.randint(2, 10), random.randint(2, 10))
+    span = [ mesh.spacing[i] * (n - 1) for i, n in enumerate((mesh.nx, mesh.ny)) ]
+    for _ in range(args.points):
+      # About a third of the points lie beyond the grid
+      raw = [ f32(mesh.start[i] + random.uniform(-0.1, 1.1) * span[i]) for i in range(2) ]
+      zs, zp, ze = mesh.stock(raw, extrapolate), mesh.patch(raw, extrapolate), mesh.exact(raw, extrapolate)
+      lookups += 1
+      same += zs == zp
+      worst_diff = max(worst_diff, abs(zs - zp))
+      worst_stock = max(worst_stock, abs(zs - ze))
+      worst_patch = max(worst_patch, abs(zp - ze))
+      if not extrapolate: worst_fixed = max(worst_fixed, abs(mesh.fixed(raw) - zs))
+
+  print('EXTRAPOLATE_BEYOND_GRID %s: %d lookups, %.1f%% identical' % ('on ' if extrapolate else 'off', lookups, 100 * same / lookups))
+  print('  stock vs. patches  %.3g µm' % (worst_diff * 1000))
+  print('  stock vs. exact    %.3g µm' % (worst_stock * 1000))
+  print('  patches vs. exact  %.3g µm' % (worst_patch * 1000))
+  failed |= worst_diff * 1000 > args.tolerance
+  if not extrapolate:
+    print('  fixed vs. stock    %.3g µm' % (worst_fixed * 1000))
+    failed |= worst_fixed * 1000 > args.bound
+
+sys.exit(1 if failed else 0)
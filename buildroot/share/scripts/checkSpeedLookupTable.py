@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""
+Measure the step timing error of the AVR speed lookup tables.
+
+Builds the tables the same way as Marlin/src/module/speed_lookuptable.h, runs every
+step rate through the same lookup and interpolation as Stepper::calc_timer_interval()
+and compares the result to the exact timer interval, STEPPER_TIMER_RATE / step_rate.
+
+  checkSpeedLookupTable.py [-f 16] [-d 8] [--hires]
+"""
+
+from __future__ import print_function, division
+
+import argparse
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('-f', '--cpu-freq', type=int, default=16, help='CPU clockrate in MHz (default=16)')
+parser.add_argument('-d', '--divider', type=int, default=8, help='Timer/counter pre-scale divider (default=8)')
+parser.add_argument('--hires', action='store_true', help='Check the HIRES_SPEED_LOOKUPTABLE tables')
+parser.add_argument('--max-rate', type=int, default=40000, help='Highest step rate to check (default=40000)')
+args = parser.parse_args()
+
+F_CPU = args.cpu_freq * 1000000
+TIMER_RATE = F_CPU // args.divider
+MIN_RATE = F_CPU // 500000
+FAST_SHIFT = 7 if args.hires else 8
+
+def interval(rate):
+  return (TIMER_RATE + rate // 2) // rate if args.hires else TIMER_RATE // rate
+
+def table(shift, entries):
+  base = [ interval((i << shift) + MIN_RATE) for i in range(entries + 1) ]
+  return [ (base[i], base[i] - base[i + 1]) for i in range(entries) ]
+
+fast = table(FAST_SHIFT, 65536 >> FAST_SHIFT)
+slow = table(3, 256)
+
+# MultiU16X8toH16 rounds the 24-bit product to its top 16 bits
+def mul_u16x8_h16(a, b):
+  return (a * b + 128) >> 8
+
+def calc_timer_interval(step_rate):
+  step_rate = max(step_rate, MIN_RATE) - MIN_RATE
+  if step_rate >= 8 * 256:
+    base, gain = fast[step_rate >> FAST_SHIFT]
+    frac = (step_rate << (8 - FAST_SHIFT)) & 0xFF
+    return base - mul_u16x8_h16(frac, gain)
+  base, gain = slow[step_rate >> 3]
+  return base - ((gain * (step_rate & 7) + (4 if args.hires else 0)) >> 3)
+
+# Worst and mean error in bands of step rates
+bands = [ MIN_RATE, 100, 1000, 2048 + MIN_RATE, 5000, 10000, 20000, args.max_rate + 1 ]
+print("F_CPU %d MHz, timer %d Hz, %s tables (%d bytes)" % (args.cpu_freq, TIMER_RATE, 'hires' if args.hires else 'standard', 4 * (len(fast) + len(slow))))
+print("%14s %12s %12s %12s" % ('step/s', 'max ticks', 'mean ticks', 'max error'))
+for lo, hi in zip(bands, bands[1:]):
+  worst = worst_rel = total = 0
+  for rate in range(lo, hi):
+    err = calc_timer_interval(rate) - TIMER_RATE / rate
+    worst = max(worst, abs(err))
+    worst_rel = max(worst_rel, abs(err) * rate / TIMER_RATE)
+    total += err
+  print("%6d-%-7d %12.3f %+12.3f %11.3f%%" % (lo, hi - 1, worst, total / (hi - lo), 100 * worst_rel))
@@ -0,0 +1,353 @@
+#!/usr/bin/env python3
+"""
+Turn a G-code file into a direct stepping stream for G6.
+
+This plans the G0/G1 moves on the host with the firmware's limits (acceleration,
+max feedrate and junction deviation), samples the motion at a fixed step rate,
+and packs the steps into pages of the firmware's STEPPER_PAGE_FORMAT. Each page
+goes out as the page manager expects it, followed by the G6 that steps it. Pages
+are used in turn, so the host streaming the file must wait for a page to be
+reported FREE before sending the next page into it. Other M and T commands pass
+through after the page they fall in. G4 dwells as a run of empty segments.
+
+The stream ends with a G92 to the final position, since G6 doesn't update it.
+
+  directStepping.py in.gcode out.gcode [--format SP_4x2_256] [--rate 24000] [--compress]
+
+With --compress each page that heatshrink makes smaller goes out compressed, for
+DIRECT_STEPPING_COMPRESSION.
+
+Use --test with a linux_native_benchmark build that has DIRECT_STEPPING to stream
+the result through the simulator. The G6 replay must take exactly the planned
+steps. The axis steps and print time of a replay of the original G-code are shown
+alongside:
+
+  directStepping.py in.gcode out.gcode --test .pio/build/linux_native_benchmark/program
+"""
+
+from __future__ import print_function, division
+
+import argparse, math, re, subprocess, sys
+
+# Steps per segment (and the most steps an axis can take in one), segments per page, directional
+FORMATS = {
+  'SP_4x4D_128': (7, 128, True),
+  'SP_4x2_256':  (3, 256, False),
+  'SP_4x1_512':  (1, 512, False)
+}
+PAGE_SIZE = 256
+AXES = 'XYZE'
+MINIMUM_PLANNER_SPEED = 0.05
+
+def floats(s): return [ float(v) for v in s.split(',') ]
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('gcode', help='G-code file to convert')
+parser.add_argument('output', help='Direct stepping stream to write')
+parser.add_argument('--format', default='SP_4x2_256', choices=sorted(FORMATS), help='STEPPER_PAGE_FORMAT (default=SP_4x2_256)')
+parser.add_argument('--pages', type=int, default=16, help='STEPPER_PAGES (default=16)')
+parser.add_argument('--rate', type=int, help='Step events per second (default=the fastest axis step rate of the moves)')
+parser.add_argument('--compress', action='store_true', help='Compress pages with heatshrink (window 8, lookahead 4)')
+parser.add_argument('--steps', type=floats, default=[ 607, 605, 1167.5, 1040 ], help='XYZE steps per mm (default=607,605,1167.5,1040)')
+parser.add_argument('--feedrate', type=floats, default=[ 40, 40, 12, 40 ], help='XYZE max feedrate, mm/s (default=40,40,12,40)')
+parser.add_argument('--max-accel', type=floats, default=[ 600, 600, 200, 300 ], help='XYZE max acceleration, mm/s^2 (default=600,600,200,300)')
+parser.add_argument('--accel', type=float, default=300, help='Acceleration, mm/s^2 (default=300)')
+parser.add_argument('--jd', type=float, default=0.01, help='Junction deviation, mm (default=0.01)')
+parser.add_argument('--invert', default='YE', help='Axes with INVERT_*_DIR set, for --test (default=YE)')
+parser.add_argument('--test', metavar='PROGRAM', help='Check the stream with this linux_native_benchmark build')
+args = parser.parse_args()
+
+SEGMENT_STEPS, SEGMENTS, DIRECTIONAL = FORMATS[args.format]
+
+def lround(v): return int(math.copysign(math.floor(abs(v) + 0.5), v))
+
+#
+# Read the moves
+#
+class Move:
+  def __init__(self, start, end, feedrate, dwell=0):
+    self.start, self.end, self.dwell = start, end, dwell
+    delta = [ e - s for s, e in zip(start, end) ]
+    self.length = math.sqrt(sum(d * d for d in delta[:3])) or abs(delta[3])
+    self.unit = [ d / self.length for d in delta ] if self.length else [ 0 ] * 4
+    # Feedrate and acceleration limited by each axis, like the planner
+    self.nominal = min([ feedrate ] + [ args.feedrate[i] / abs(u) for i, u in enumerate(self.unit) if u ])
+    self.accel = min([ args.accel ] + [ args.max_accel[i] / abs(u) for i, u in enumerate(self.unit) if u ])
+    self.entry = self.exit = 0
+
+  def peak_step_rate(self):
+    return max(abs(u) * self.nominal * args.steps[i] for i, u in enumerate(self.unit))
+
+  def limit_step_rate(self, rate):
+    # Slow down to stay within the step rate on every axis
+    for i, u in enumerate(self.unit):
+      if u: self.nominal = min(self.nominal, rate / (abs(u) * args.steps[i]))
+
+  def plan(self):
+    # Accelerate from the entry speed, cruise, and decelerate to the exit speed
+    a, v0, v1, L = self.accel, self.entry, self.exit, self.length
+    vp = min(self.nominal, math.sqrt((2 * a * L + v0 * v0 + v1 * v1) / 2))
+    self.peak = vp
+    self.t_accel = (vp - v0) / a
+    self.t_decel = (vp - v1) / a
+    cruise = L - (vp * vp - v0 * v0) / (2 * a) - (vp * vp - v1 * v1) / (2 * a)
+    self.t_cruise = max(0, cruise / vp) if vp else 0
+    self.duration = self.dwell or (self.t_accel + self.t_cruise + self.t_decel)
+
+  def distance(self, t):
+    a, v0, vp = self.accel, self.entry, self.peak
+    if t <= self.t_accel: return v0 * t + a * t * t / 2
+    s = v0 * self.t_accel + a * self.t_accel ** 2 / 2
+    t -= self.t_accel
+    if t <= self.t_cruise: return s + vp * t
+    s += vp * self.t_cruise
+    t = min(t - self.t_cruise, self.t_decel)
+    return min(self.length, s + vp * t - a * t * t / 2)
+
+  def position(self, t):
+    if not self.length: return self.start
+    s = self.distance(t)
+    return [ p + u * s for p, u in zip(self.start, self.unit) ]
+
+def read_gcode(filename):
+  """Moves, and the other commands with the index of the move they follow"""
+  moves, commands = [], []
+  pos, feedrate = [ 0.0 ] * 4, 25.0
+  relative = relative_e = False
+  for line in open(filename):
+    line = line.split(';')[0].strip()
+    if not line: continue
+    words = dict((w[0].upper(), w[1:]) for w in re.findall(r'[A-Za-z][-+.\d]*', line))
+    code = line.split()[0].upper()
+    if code in ('G0', 'G1'):
+      if 'F' in words: feedrate = float(words['F']) / 60
+      end = list(pos)
+      for i, axis in enumerate(AXES):
+        if axis in words:
+          v = float(words[axis])
+          end[i] = pos[i] + v if (relative_e if axis == 'E' else relative) else v
+      if end != pos: moves.append(Move(pos, end, feedrate))
+      pos = end
+    elif code == 'G4':
+      dwell = float(words.get('P', 0)) / 1000 + float(words.get('S', 0))
+      if dwell > 0: moves.append(Move(pos, pos, feedrate, dwell))
+    elif code == 'G92':
+      for i, axis in enumerate(AXES):
+        if axis in words: pos[i] = float(words[axis])
+      commands.append((len(moves), line))  # Doesn't move, but the firmware has to know
+    elif code in ('G90', 'G91'):
+      relative = relative_e = code == 'G91'
+    elif code in ('M82', 'M83'):
+      relative_e = code == 'M83'
+    elif code == 'G21':
+      pass
+    elif code[0] in 'MT':
+      commands.append((len(moves), line))
+    else:
+      sys.exit("%s isn't supported: %s" % (code, line))
+  return moves, commands, pos
+
+def plan(moves):
+  """Junction speeds from junction deviation, then the reverse and forward passes"""
+  prev = None
+  for m in moves:
+    if prev is None or not m.length or not prev.length:
+      m.max_entry = 0
+    else:
+      cos_theta = -sum(a * b for a, b in zip(prev.unit, m.unit))
+      if cos_theta > 0.999999:
+        vj = MINIMUM_PLANNER_SPEED
+      elif cos_theta < -0.999999:
+        vj = float('inf')
+      else:
+        sin_theta_d2 = math.sqrt(0.5 * (1 - cos_theta))
+        vj = math.sqrt(m.accel * args.jd * sin_theta_d2 / (1 - sin_theta_d2))
+      m.max_entry = min(vj, m.nominal, prev.nominal)
+    prev = m
+  exit_speed = 0
+  for m in reversed(moves):
+    m.exit = exit_speed
+    m.entry = min(m.max_entry, math.sqrt(exit_speed ** 2 + 2 * m.accel * m.length))
+    exit_speed = m.entry
+  entry_speed = 0
+  for m in moves:
+    m.entry = min(m.entry, entry_speed)
+    m.exit = min(m.exit, math.sqrt(m.entry ** 2 + 2 * m.accel * m.length))
+    entry_speed = m.exit
+  for m in moves: m.plan()
+
+#
+# Sample the motion
+#
+def segments(moves, rate):
+  """Steps of each axis in each segment, with the index of the move where the segment ends"""
+  period = SEGMENT_STEPS / rate
+  to_steps = lambda pos: [ lround(p * s) for p, s in zip(pos, args.steps) ]
+  last = to_steps(moves[0].start) if moves else [ 0 ] * 4
+  t0 = 0  # Start of the current move
+  k = 1
+  for index, m in enumerate(moves):
+    if index and m.start != moves[index - 1].end:
+      # A G92 moved the origin, not the axes
+      last = [ l + a - b for l, a, b in zip(last, to_steps(m.start), to_steps(moves[index - 1].end)) ]
+    while k * period <= t0 + m.duration:
+      now = to_steps(m.position(k * period - t0))
+      yield [ n - l for n, l in zip(now, last) ], index
+      last, k = now, k + 1
+    t0 += m.duration
+  # The rest of the last move, to land on its end
+  if moves:
+    end = to_steps(moves[-1].end)
+    while end != last:
+      now = [ l + max(-SEGMENT_STEPS, min(SEGMENT_STEPS, e - l)) for e, l in zip(end, last) ]
+      yield [ n - l for n, l in zip(now, last) ], len(moves) - 1
+      last = now
+
+#
+# heatshrink compression, as libs/heatshrink decodes it
+#
+def heatshrink(data, window_bits=8, lookahead_bits=4):
+  window, longest = 1 << window_bits, 1 << lookahead_bits
+  out, acc, nbits = bytearray(), 0, 0
+  def put(value, bits):
+    nonlocal acc, nbits
+    acc, nbits = (acc << bits) | value, nbits + bits
+    while nbits >= 8:
+      nbits -= 8
+      out.append((acc >> nbits) & 0xFF)
+  chains, i = {}, 0
+  def remember(j):
+    if j + 1 < len(data): chains.setdefault(data[j:j + 2], []).append(j)
+  while i < len(data):
+    best, dist = 0, 0
+    for j in reversed(chains.get(data[i:i + 2], [])[-32:]):
+      if i - j > window: break
+      n = 0
+      while n < longest and i + n < len(data) and data[j + n] == data[i + n]: n += 1
+      if n > best: best, dist = n, i - j
+      if n == longest: break
+    if best >= 2:
+      put(0, 1); put(dist - 1, window_bits); put(best - 1, lookahead_bits)
+      for j in range(i, i + best): remember(j)
+      i += best
+    else:
+      put(1, 1); put(data[i], 8)
+      remember(i)
+      i += 1
+  if nbits: put(0, 8 - nbits)
+  return bytes(out)
+
+#
+# Pack the pages
+#
+def pack(segs):
+  if args.format == 'SP_4x4D_128':
+    data = bytearray()
+    for s in segs: data += bytes([ (s[0] + 7) << 4 | (s[1] + 7), (s[2] + 7) << 4 | (s[3] + 7) ])
+    return bytes(data) + b'\x77' * (PAGE_SIZE - len(data))
+  if args.format == 'SP_4x2_256':
+    return bytes(abs(s[0]) << 6 | abs(s[1]) << 4 | abs(s[2]) << 2 | abs(s[3]) for s in segs)
+  nibbles = [ abs(s[0]) << 3 | abs(s[1]) << 2 | abs(s[2]) << 1 | abs(s[3]) for s in segs ] + [ 0 ]
+  return bytes(nibbles[k] | nibbles[k + 1] << 4 for k in range(0, len(segs), 2))
+
+class Stream:
+  def __init__(self, f, rate):
+    self.f, self.rate = f, rate
+    self.pages = self.raw_bytes = self.sent_bytes = 0
+    self.dirs = None
+
+  def page(self, segs, dirs):
+    idx = self.pages % args.pages
+    data = pack(segs)
+    check = 0
+    frame = b'!' + bytes([ idx ])
+    if not DIRECTIONAL: frame += bytes([ len(data) & 0xFF ])
+    self.raw_bytes += len(frame) + len(data) + 2
+    if args.compress:
+      packed = heatshrink(data)
+      if len(packed) < len(data):
+        frame, data = b'#' + bytes([ idx, len(packed) ]), packed
+    for b in data: check ^= b
+    self.f.write(frame + data + bytes([ check ]) + b'\n')
+    self.sent_bytes += len(frame) + len(data) + 2
+
+    g6 = 'G6'
+    if not self.pages: g6 += ' R%d' % self.rate
+    if not DIRECTIONAL:
+      for i, axis in enumerate(AXES):
+        if self.dirs is None or dirs[i] != self.dirs[i]: g6 += ' %s%d' % (axis, dirs[i])
+      self.dirs = dirs
+    g6 += ' I%d' % idx
+    if len(segs) < SEGMENTS and not DIRECTIONAL: g6 += ' S%d' % (len(segs) * SEGMENT_STEPS)
+    self.text(g6)
+    self.pages += 1
+
+  def text(self, line):
+    self.f.write(line.encode() + b'\n')
+    self.raw_bytes += len(line) + 1
+    self.sent_bytes += len(line) + 1
+
+def convert():
+  moves, commands, end = read_gcode(args.gcode)
+  rate = args.rate or int(math.ceil(max([ m.peak_step_rate() for m in moves if m.length ] or [ 1 ]) * 1.001)) + 1
+  for m in moves: m.limit_step_rate(rate)
+  plan(moves)
+  print_time = sum(m.duration for m in moves)
+
+  with open(args.output, 'wb') as f:
+    stream = Stream(f, rate)
+    page, dirs = [], [ 1 ] * 4
+    def send():
+      # After the page, the commands that came before the last move in it
+      stream.page(page, dirs)
+      while commands and commands[0][0] <= move_index: stream.text(commands.pop(0)[1])
+
+    move_index = -1
+    total = [ 0 ] * 4
+    for steps, move_index in segments(moves, rate):
+      total = [ t + s for t, s in zip(total, steps) ]
+      if any(abs(s) > SEGMENT_STEPS for s in steps):
+        sys.exit("Too many steps in a segment. Use a higher --rate.")
+      if not DIRECTIONAL:
+        # Start a new page when an axis reverses
+        want = [ (s > 0) if s else d for s, d in zip(steps, dirs) ]
+        if want != dirs and page:
+          send()
+          page = []
+        dirs = want
+      page.append(steps)
+      if len(page) == SEGMENTS:
+        send()
+        page = []
+    if page: send()
+    for c in commands: stream.text(c[1])
+    stream.text('G92 ' + ' '.join('%s%.5f' % (a, p) for a, p in zip(AXES, end)))
+
+  print("%s: %d moves, %.3f s planned, %d pages at %d steps/s" % (args.output, len(moves), print_time, stream.pages, rate))
+  print("  %d bytes, %.2fx smaller than with raw pages" % (stream.sent_bytes, stream.raw_bytes / max(1, stream.sent_bytes)))
+  return total
+
+def run(gcode):
+  """Axis steps, print time and errors of a benchmark replay"""
+  result = subprocess.run([ args.test, gcode ], stdout=subprocess.PIPE, stderr=subprocess.PIPE, timeout=3600)
+  out = result.stdout.decode(errors='replace')
+  steps = re.search(r'Axis steps\s*:(.*)', out)
+  time = re.search(r'Print time\s*:\s*([\d.]+)', out)
+  if result.returncode or not steps or not time:
+    sys.exit("%s failed on %s:\n%s" % (args.test, gcode, out))
+  errors = [ l for l in result.stderr.decode(errors='replace').splitlines() if re.search(r'Bad page|Page \d+ failed', l) ]
+  return dict(re.findall(r'([XYZE]):(-?\d+)', steps.group(1))), float(time.group(1)), errors
+
+total = convert()
+
+if args.test:
+  # G6 has to take exactly the planned steps. The G-code replay is only for comparison,
+  # since its counts include steps that G6 doesn't take, like backlash compensation.
+  expected = { a: str(-t if a in args.invert.upper() else t) for a, t in zip(AXES, total) }
+  (g1_steps, g1_time, _), (g6_steps, g6_time, errors) = run(args.gcode), run(args.output)
+  print("%8s %12s %12s %12s" % ('', 'planned', 'G-code', 'G6'))
+  for axis in AXES:
+    print("%8s %12s %12s %12s" % (axis + ' steps', expected[axis], g1_steps.get(axis, '-'), g6_steps.get(axis, '-')))
+  print("%8s %12s %12.3f %12.3f" % ('time', '', g1_time, g6_time))
+  for e in errors[:10]: print(e)
+  sys.exit(1 if errors or g6_steps != expected else 0)
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+Analyze a binary step trace from the LINUX HAL.
+
+The trace records every step of X, Y, Z and E0 with its time in ns. Make one with
+the linux_native_benchmark build:
+
+  program <file.gcode> [time_multiplier] <step_trace.bin>
+
+This bins the steps by time, then estimates each axis velocity as the mean over
+a window on each side of every bin edge. The difference of the two is the
+velocity change at that edge: acceleration times the window, plus any jump.
+A jump bigger than the jerk limit, the change the acceleration limit allows,
+and 2 steps of quantization over the window is a jerk violation.
+
+Use --csv to write out the velocity and acceleration of every bin, for plotting.
+Use --compare to check another trace of the same moves against this one, e.g.
+from a build before a planner change.
+
+  stepTrace.py step_trace.bin [--axes XYZ] [--window 0.004] [--csv out.csv] [--compare other.bin]
+"""
+
+from __future__ import print_function, division
+
+import argparse, array, struct, sys
+
+AXES = 'XYZE'
+
+def floats(s): return [ float(v) for v in s.split(',') ]
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('trace', help='Step trace file')
+parser.add_argument('--steps', type=floats, default=[ 607, 605, 1167.5, 1040 ], help='XYZE steps per mm (default=607,605,1167.5,1040)')
+parser.add_argument('--accel', type=floats, default=[ 600, 600, 200, 300 ], help='XYZE max acceleration, mm/s^2 (default=600,600,200,300)')
+parser.add_argument('--jerk', type=floats, default=[ 2, 2, 0.4, 1 ], help='XYZE max velocity jump, mm/s (default=2,2,0.4,1)')
+parser.add_argument('--axes', default='XYZ', help='Axes to check for jerk violations (default=XYZ; E jumps by design with LIN_ADVANCE)')
+parser.add_argument('--bin', type=float, default=0.0005, help='Time bin, s (default=0.0005)')
+parser.add_argument('--window', type=float, default=0.004, help='Velocity window each side of a bin edge, s (default=0.004)')
+parser.add_argument('--show', type=int, default=10, help='Violations to list (default=10)')
+parser.add_argument('--csv', help='Write time, velocity and acceleration per bin to this file')
+parser.add_argument('--compare', help='Another trace to compare positions with')
+args = parser.parse_args()
+
+def load(filename):
+  """Steps as (time ns, axis, +1/-1) lists per axis"""
+  with open(filename, 'rb') as f:
+    magic, version, size, dropped = struct.unpack('<4sHHQ', f.read(16))
+    if magic != b'MSTP' or version != 1 or size != 8:
+      sys.exit("%s is not a version 1 step trace" % filename)
+    records = array.array('Q')
+    records.frombytes(f.read())
+  if sys.byteorder != 'little': records.byteswap()
+  if dropped: print("Warning: %s is missing %d dropped steps" % (filename, dropped))
+  steps = [ [] for _ in AXES ]
+  for r in records:
+    steps[r & 0x7].append((r >> 4, 1 if r & 0x8 else -1))
+  return steps
+
+def start_time(steps):
+  return min([ s[0][0] for s in steps if s ] or [ 0 ])
+
+def binned(steps, t0, bin_ns):
+  """Net steps per time bin for each axis"""
+  end = max([ s[-1][0] for s in steps if s ] or [ t0 ])
+  count = (end - t0) // bin_ns + 1
+  bins = [ [ 0 ] * count for _ in steps ]
+  for axis, s in enumerate(steps):
+    b = bins[axis]
+    for t, d in s: b[(t - t0) // bin_ns] += d
+  return bins
+
+trace = load(args.trace)
+t0 = start_time(trace)
+bin_ns = int(args.bin * 1e9)
+bins = binned(trace, t0, bin_ns)
+nbins = len(bins[0])
+w = max(1, int(round(args.window / args.bin)))   # Window, in bins
+window = w * args.bin
+
+print("%s: %.3f s" % (args.trace, nbins * args.bin))
+print("%5s %10s %12s %14s %14s %11s" % ('axis', 'steps', 'max mm/s', 'max mm/s^2', 'worst jump', 'violations'))
+
+csv = [ [ (k * args.bin) for k in range(nbins + 1) ] ] if args.csv else None
+total_violations = 0
+for axis, name in enumerate(AXES):
+  spm, b = args.steps[axis], bins[axis]
+  # Position at each bin edge, in steps
+  pos = [ 0 ] * (nbins + 1)
+  for k in range(nbins): pos[k + 1] = pos[k] + b[k]
+  # Mean velocity over the window before and after each edge, in mm/s
+  vel = lambda k0, k1: (pos[k1] - pos[k0]) / ((k1 - k0) * args.bin * spm)
+  allowed = args.jerk[axis] + args.accel[axis] * window + 2 / (spm * window)
+  check = name in args.axes.upper()
+
+  vmax = amax = 0
+  worst = -allowed
+  violations = []
+  vcol, acol = [], []
+  for k in range(nbins + 1):
+    before = vel(max(0, k - w), k) if k else 0
+    after = vel(k, min(nbins, k + w)) if k < nbins else 0
+    dv = after - before
+    vmax = max(vmax, abs(after))
+    amax = max(amax, abs(dv) / window)
+    if abs(dv) - allowed > worst: worst = abs(dv) - allowed
+    if check and abs(dv) > allowed: violations.append((k * args.bin, before, after))
+    if csv is not None: vcol.append(after); acol.append(dv / window)
+
+  # Each jump shows at the edges of a few bins, so count each run once
+  runs = [ v for i, v in enumerate(violations) if i == 0 or v[0] - violations[i - 1][0] > args.bin * 1.5 ]
+  total_violations += len(runs)
+  print("%5s %10d %12.2f %14.1f %+14.2f %11s" % (name, len(trace[axis]), vmax, amax, worst, len(runs) if check else '-'))
+  for t, v0, v1 in runs[:args.show]:
+    print("        %10.4f s: %8.2f -> %8.2f mm/s" % (t, v0, v1))
+  if csv is not None: csv += [ vcol, acol ]
+
+print("Worst jump is the velocity change over the allowed change, in mm/s")
+
+if args.csv:
+  with open(args.csv, 'w') as f:
+    f.write('t,' + ','.join('v%s,a%s' % (a, a) for a in AXES) + '\n')
+    for row in zip(*csv): f.write(','.join('%.6g' % v for v in row) + '\n')
+
+if args.compare:
+  # Positions of both traces at each bin edge, from their own starts
+  other = load(args.compare)
+  obins = binned(other, start_time(other), bin_ns)
+  print("%s: %.3f s" % (args.compare, len(obins[0]) * args.bin))
+  print("%5s %14s %16s %14s" % ('axis', 'steps', 'end position', 'max mm apart'))
+  for axis, name in enumerate(AXES):
+    a, b = bins[axis], obins[axis]
+    p = q = apart = 0
+    for k in range(max(len(a), len(b))):
+      p += a[k] if k < len(a) else 0
+      q += b[k] if k < len(b) else 0
+      apart = max(apart, abs(p - q))
+    print("%5s %+14d %+16d %14.3f" % (name, len(other[axis]) - len(trace[axis]), q - p, apart / args.steps[axis]))
+
+sys.exit(1 if total_violations else 0)